@@ -0,0 +1,82 @@
+// Сравнение JsonWriter с nlohmann::json::dump на одном тике
+// с большим количеством рядов.
+//
+// Запуск: ./jsonl_benchmark [series] [iterations]
+#include "output/JsonlOutput.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+class BenchMetric : public IMetric {
+public:
+    explicit BenchMetric(std::string name) : name_(std::move(name)) {}
+
+    MetricValue collect() const override { return MetricValue{}; }
+    bool is_valid() const override { return true; }
+    std::string name() const override { return name_; }
+
+private:
+    std::string name_;
+};
+
+template <typename F>
+double measure_ns(size_t iterations, F &&f) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    size_t series = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+    BenchMetric cpu("cpu");
+    BenchMetric memory("memory");
+
+    std::vector<double> usage(series / 2);
+    for (size_t i = 0; i < usage.size(); ++i) {
+        usage[i] = 100.0 * static_cast<double>(i) / static_cast<double>(usage.size() + 1);
+    }
+    std::map<std::string, double> meminfo;
+    for (size_t i = 0; i < series - usage.size(); ++i) {
+        meminfo["Field" + std::to_string(i)] = 1024.0 * static_cast<double>(i) + 0.5;
+    }
+
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values = {
+        {&cpu, usage}, {&memory, meminfo}};
+    const int64_t timestamp_ms = 1700000000123;
+
+    JsonWriter writer;
+    JsonlOutput::MetricKeys keys;
+    size_t writer_bytes = 0;
+    double writer_ns = measure_ns(iterations, [&] {
+        writer.clear();
+        JsonlOutput::serialize(writer, timestamp_ms, metric_values, keys);
+        writer_bytes += writer.size();
+    });
+
+    size_t dump_bytes = 0;
+    double dump_ns = measure_ns(iterations, [&] {
+        json record;
+        record["timestamp"] = timestamp_ms;
+        record["cpu"] = usage;
+        record["memory"] = meminfo;
+        dump_bytes += record.dump().size();
+    });
+
+    std::cout << "series: " << series << ", iterations: " << iterations << "\n"
+              << "JsonWriter:           " << writer_ns / 1000.0 << " us/tick ("
+              << writer_bytes / iterations << " bytes)\n"
+              << "nlohmann::json::dump: " << dump_ns / 1000.0 << " us/tick ("
+              << dump_bytes / iterations << " bytes)\n"
+              << "speedup: " << dump_ns / writer_ns << "x" << std::endl;
+
+    return 0;
+}
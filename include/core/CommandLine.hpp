@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+
+// Параметры командной строки:
+//   status_monitor [--verbose] [--startup-profile] [--once | --count N]
+//                  [--duration T] [--window T] [--format jsonl|prometheus]
+//                  <config_file>
+// Длительности задаются числом с суффиксом ms, s, m или h (без суффикса - секунды).
+struct CommandLine {
+    std::string config_path;
+    // Подробный журнал запуска и сбора
+    bool verbose = false;
+    // Вывести в stderr разбивку времени от запуска до первого тика
+    bool startup_profile = false;
+
+    // Ограниченный запуск: число тиков (0 - без ограничения) и
+    // длительность в мс (0 - без ограничения)
+    int64_t count = 0;
+    int64_t duration_ms = 0;
+    // Окно первого замера метрик-скоростей в мс (0 - как в конфигурации);
+    // для --once по умолчанию kOnceWindowMs
+    int64_t window_ms = 0;
+    // Формат вывода в stdout: "", "jsonl" или "prometheus"
+    std::string format;
+
+    static constexpr int64_t kOnceWindowMs = 100;
+
+    bool bounded() const { return count > 0 || duration_ms > 0; }
+
+    // Подставляет window_ms в конфигурацию встроенных метрик cpu, net и disk,
+    // где окно не задано явно. Сторонние плагины (другой тип или своя
+    // библиотека) не трогаются: их конфигурация может не знать window_ms.
+    void apply_window(nlohmann::json &config) const;
+
+    // Бросает std::invalid_argument при неизвестном флаге или без пути к конфигурации
+    static CommandLine parse(int argc, const char* const argv[]);
+
+    // Разбирает длительность вида "100ms", "2s", "1.5m"; бросает std::invalid_argument
+    static int64_t parse_duration_ms(const std::string &text);
+
+    static std::string usage(const std::string &program);
+};
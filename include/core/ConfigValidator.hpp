@@ -0,0 +1,11 @@
+#pragma once
+
+#include "metrics/IMetric.hpp"
+#include <string>
+#include <vector>
+
+// Проверяет структуру конфигурации за один проход и возвращает все
+// найденные ошибки, а не только первую. Параметры самих метрик и выходов
+// проверяют их конструкторы при создании. Без require_outputs секция
+// outputs может отсутствовать или быть пустой (вывод задан флагом --format).
+std::vector<std::string> validate_config(const json &config, bool require_outputs = true);
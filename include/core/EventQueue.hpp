@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core/Timestamp.hpp"
+#include "metrics/IMetric.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Очередь внеочередных значений метрик. Метрики кладут значения из своих
+// потоков, основной цикл ждёт на ней вместо сна до следующего тика.
+class EventQueue {
+public:
+    struct Event {
+        Timestamp tick;
+        const IMetric* metric;
+        MetricValue value;
+    };
+
+    explicit EventQueue(size_t capacity = 1024) : capacity_(capacity) {}
+
+    // При переполнении отбрасывается самое старое событие
+    void push(const IMetric* metric, MetricValue value);
+
+    // Ждёт событий до deadline и переносит их в out.
+    // Возвращает false, если событий не было.
+    bool wait_until(std::chrono::steady_clock::time_point deadline, std::vector<Event> &out);
+
+    // Функция для IMetric::set_event_callback
+    IMetric::EventCallback callback();
+
+    size_t dropped() const;
+
+private:
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Event> events_;
+    size_t dropped_ = 0;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "metrics/IMetric.hpp"
+#include <cstdint>
+
+// Ограничитель собственных накладных расходов монитора.
+// Каждый тик измеряет потраченное процессом время CPU и при превышении
+// бюджета поэтапно растягивает период сбора, а на последней ступени
+// пропускает метрики с низким приоритетом. При появлении запаса решения
+// откатываются. Текущее состояние доступно как метрика "governor".
+class OverheadGovernor : public IMetric {
+public:
+    OverheadGovernor() = default;
+
+    // config - объект settings.governor:
+    // {"budget": 0.5, "max_stretch": 8, "pin_cpu": 3}
+    explicit OverheadGovernor(const json &config);
+
+    bool enabled() const { return enabled_; }
+
+    // Измеряет потребление CPU процессом с прошлого вызова и пересчитывает решения
+    void update();
+
+    // То же по заданным приращениям времени процесса и реального времени
+    void update(int64_t cpu_ns, int64_t wall_ns);
+
+    // Множитель периода сбора
+    int stretch() const;
+
+    // Нужно ли пропустить метрику с данным приоритетом
+    bool skip(int priority) const;
+
+    int level() const { return level_; }
+    double usage_percent() const { return usage_percent_; }
+
+    // Привязывает вызывающий поток к pin_cpu, если он задан. Потоки,
+    // созданные после этого (потоки метрик и выходов), наследуют привязку.
+    void pin_current_thread() const;
+
+    MetricValue collect() const override;
+    bool is_valid() const override { return enabled_; }
+    std::string name() const override { return "governor"; }
+
+private:
+    static constexpr int kCooldownTicks = 3;
+    static constexpr double kRestoreRatio = 0.5;
+
+    int max_level() const;
+
+    bool enabled_ = false;
+    double budget_percent_ = 0.0;
+    int max_stretch_ = 8;
+    int pin_cpu_ = -1;
+
+    int level_ = 0;
+    int calm_ticks_ = 0;
+    double usage_percent_ = 0.0;
+
+    bool has_baseline_ = false;
+    int64_t last_cpu_ns_ = 0;
+    int64_t last_wall_ns_ = 0;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Разбивка времени запуска от exec до первого выведенного тика.
+// Этапы отмечаются по порядку вызовом mark(), вложенные замеры (например,
+// загрузка отдельных метрик) добавляются через add(). Время до main()
+// (загрузка исполняемого файла, динамическая линковка, статическая
+// инициализация) берётся из времени старта процесса в /proc/self/stat.
+class StartupProfile {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit StartupProfile(bool enabled);
+
+    bool enabled() const { return enabled_; }
+
+    // Завершает этап, начавшийся с предыдущей отметки
+    void mark(const std::string &phase);
+
+    // Добавляет вложенный замер к следующему этапу
+    void add(const std::string &name, Clock::duration duration);
+
+    void report(std::ostream &out) const;
+
+private:
+    struct Entry {
+        std::string name;
+        int64_t ns;
+        bool nested;
+    };
+
+    bool enabled_;
+    int64_t before_main_ns_ = -1;
+    Clock::time_point start_;
+    Clock::time_point last_;
+    std::vector<Entry> entries_;
+    std::vector<Entry> nested_;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+// Отметка времени тика. Снимается один раз в начале тика и передаётся
+// всем выходам, чтобы они не расходились во времени.
+struct Timestamp {
+    // CLOCK_MONOTONIC: для интервалов (deadband, heartbeat)
+    int64_t monotonic_ns = 0;
+    // CLOCK_REALTIME: для вывода
+    int64_t realtime_ns = 0;
+
+    static Timestamp now() {
+        timespec monotonic{};
+        timespec realtime{};
+        clock_gettime(CLOCK_MONOTONIC, &monotonic);
+        clock_gettime(CLOCK_REALTIME, &realtime);
+        return Timestamp{to_ns(monotonic), to_ns(realtime)};
+    }
+
+    int64_t realtime_ms() const { return realtime_ns / 1000000; }
+
+private:
+    static int64_t to_ns(const timespec &ts) {
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Форматирует время в ISO-8601 с миллисекундами и смещением часового пояса:
+// 2024-01-02T03:04:05.678+03:00. Часть до секунд кэшируется, поэтому
+// localtime/strftime вызываются не чаще раза в секунду.
+class TimestampFormatter {
+public:
+    // Результат действителен до следующего вызова
+    std::string_view format(int64_t realtime_ns);
+
+private:
+    void update_prefix(int64_t second);
+
+    int64_t cached_second_ = INT64_MIN;
+    char prefix_[32] = {};
+    size_t prefix_size_ = 0;
+    char offset_[8] = {};
+    size_t offset_size_ = 0;
+    char buffer_[48] = {};
+};
@@ -1,12 +1,17 @@
 #pragma once
 
+#include "CounterRates.hpp"
 #include "IMetric.hpp"
-#include <map>
+#include "UsageAccumulator.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 class CPUMetric : public IMetric {
 public:
     explicit CPUMetric(const json &config);
+    ~CPUMetric();
 
     MetricValue collect() const override;
     bool is_valid() const override;
@@ -14,29 +19,42 @@ public:
 
 private:
     std::vector<int> cpu_ids_;
-
-    struct CPUStats {
-        unsigned long long user;
-        unsigned long long nice;
-        unsigned long long system;
-        unsigned long long idle;
-        unsigned long long iowait;
-        unsigned long long irq;
-        unsigned long long softirq;
-        unsigned long long steal;
-        unsigned long long guest;
-
-        unsigned long long idle_time() const { return idle + iowait; }
-
-        // Общее время работы
-        unsigned long long total_time() const {
-            return idle_time() + user + nice + system + irq + softirq + steal;
-        }
-    };
-
-    // Кэш для хранения предыдущих значений
-    mutable std::map<int, CPUStats> prev_stats_;
-
-    // Флаг, указывающий, что это первое измерение
-    mutable bool first_measurement_ = true;
+    // Позиция ядра в cpu_ids_ по его номеру (kNoIndex - ядро не выбрано)
+    static constexpr size_t kNoIndex = static_cast<size_t>(-1);
+    std::vector<size_t> cpu_index_;
+
+    // Счётчики строки cpuN в /proc/stat
+    enum Counter { User, Nice, System, Idle, Iowait, Irq, Softirq, Steal, Guest, kCounters };
+
+    // Читает /proc/stat и пишет загрузку выбранных ядер в usage (в порядке
+    // cpu_ids_); present отмечает ядра, для которых есть приращение
+    bool read_usage(CounterRates &rates, std::vector<char> &buffer,
+                    std::vector<double> &usage, std::vector<char> &present) const;
+
+    int stat_fd_ = -1;
+
+    // Приращения счётчиков между вызовами collect()
+    mutable CounterRates rates_{kCounters};
+    // Минимальное окно между замерами (окно первого периода после загрузки)
+    int64_t window_ns_ = 0;
+    mutable std::vector<char> collect_buffer_;
+
+    // Режим частых замеров: фоновый поток снимает загрузку каждые
+    // subsample_ms, а collect() отдаёт min/max/mean/p95 за период
+    void sample_loop();
+    MetricValue collect_subsampled() const;
+
+    int subsample_ms_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_ = false;
+    // Поток сделал хотя бы один замер с приращениями; до этого collect() ждёт
+    bool sampled_ = false;
+    mutable std::condition_variable sample_cv_;
+    std::thread sampler_;
+
+    // Накопители по ядрам: в один пишет поток замеров, второй отдаётся в collect()
+    mutable std::vector<UsageAccumulator> accumulators_;
+    mutable std::vector<UsageAccumulator> snapshot_;
 };
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CounterRates.hpp"
+#include "DeviceFilter.hpp"
+#include "ProcFile.hpp"
+#include "core/Timestamp.hpp"
+#include <fcntl.h>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+// Файл procfs со счётчиками по устройствам (/proc/net/dev, /proc/diskstats)
+// вместе с их CounterRates. Разбирает общие параметры метрики:
+// - proc_root: корень procfs (по умолчанию "/proc");
+// - window_ms: минимальное окно между замерами;
+// - include/exclude: шаблоны имён устройств (см. DeviceFilter).
+//
+// Замер: read() (ждёт окно, читает файл и начинает замер в rates()), затем
+// rates().update() для каждого устройства и rates().end().
+class CounterFile {
+public:
+    // metric - имя метрики для сообщений об ошибках ("Net"), relative - путь
+    // файла относительно proc_root, what - описание данных для журнала
+    CounterFile(const nlohmann::json &config, const char* metric, const char* relative,
+                const char* what, size_t width)
+        : rates_(width, DeviceFilter(config)), buffer_(16384) {
+        std::string proc_root = "/proc";
+        if (config.contains("proc_root")) {
+            if (!config["proc_root"].is_string()) {
+                throw std::invalid_argument(std::string(metric) + " 'proc_root' must be a string");
+            }
+            proc_root = config["proc_root"].get<std::string>();
+        }
+
+        if (config.contains("window_ms")) {
+            if (!config["window_ms"].is_number_integer() || config["window_ms"].get<int>() < 0) {
+                throw std::invalid_argument(std::string(metric) +
+                                            " 'window_ms' must be a non-negative integer");
+            }
+            window_ns_ = config["window_ms"].get<int64_t>() * 1000000;
+        }
+
+        std::string path = proc_root + "/" + relative;
+        fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            std::cerr << what << " are unavailable: " << path << std::endl;
+        }
+    }
+
+    ~CounterFile() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    CounterFile(const CounterFile &) = delete;
+    CounterFile &operator=(const CounterFile &) = delete;
+
+    bool is_open() const { return fd_ >= 0; }
+
+    // С окном база снимается при загрузке метрики, и уже первый период
+    // содержит значения: метрика вызывает свой collect() в конструкторе
+    bool needs_baseline() const { return window_ns_ > 0 && fd_ >= 0; }
+
+    // Ждёт окно, читает файл целиком и начинает замер. Ждать нужно до чтения:
+    // приращения должны относиться к моменту чтения. Пустой результат -
+    // файл недоступен, замер не начат.
+    std::string_view read() {
+        if (fd_ < 0) {
+            return {};
+        }
+        rates_.wait_interval(window_ns_, Timestamp::now().monotonic_ns);
+        int64_t now_ns = Timestamp::now().monotonic_ns;
+        ssize_t size = procfile::read_all(fd_, buffer_);
+        if (size <= 0) {
+            return {};
+        }
+        rates_.begin(now_ns);
+        return std::string_view(buffer_.data(), static_cast<size_t>(size));
+    }
+
+    CounterRates &rates() { return rates_; }
+
+private:
+    int fd_ = -1;
+    // Минимальное окно между замерами; 0 - первый замер служит только базой
+    int64_t window_ns_ = 0;
+    CounterRates rates_;
+    std::vector<char> buffer_;
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Вычисление приращений монотонных счётчиков по устройствам (CPU, сетевые
+// интерфейсы, диски) между двумя замерами.
+//
+// Замер: begin(now), затем update() для каждого устройства, затем end().
+// - Новое устройство в первом замере только запоминается как база.
+// - Устройство, не обновлённое в замере, считается исчезнувшим и забывается.
+// - Если счётчик уменьшился, он был сброшен (устройство пересоздано под
+//   тем же именем) - значения становятся новой базой. Только для заведомо
+//   32-битных счётчиков (wraps_32bit) уменьшение считается переполнением.
+//
+// Устройства обычно идут в одном и том же порядке, поэтому поиск сначала
+// проверяет следующий по порядку слот и лишь затем обращается к хеш-таблице.
+// Фильтр accept вызывается один раз за время жизни устройства.
+class CounterRates {
+public:
+    using Filter = std::function<bool(std::string_view)>;
+
+    explicit CounterRates(size_t width, Filter accept = nullptr, bool wraps_32bit = false)
+        : width_(width), accept_(std::move(accept)), wraps_32bit_(wraps_32bit), delta_(width) {}
+
+    size_t width() const { return width_; }
+
+    // Начало замера в момент now_ns (CLOCK_MONOTONIC)
+    void begin(int64_t now_ns) {
+        prev_ns_ = now_ns_;
+        now_ns_ = now_ns;
+        ++round_;
+        cursor_ = 0;
+    }
+
+    // Если с последнего замера прошло меньше min_interval_ns, ждёт остаток.
+    // Позволяет снять базу заранее (например, при загрузке метрики) и
+    // получить первое значение по окну нужной длины.
+    void wait_interval(int64_t min_interval_ns, int64_t now_ns) const {
+        int64_t remaining = min_interval_ns - (now_ns - now_ns_);
+        if (now_ns_ > 0 && remaining > 0) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(remaining));
+        }
+    }
+
+    // Секунды между текущим и предыдущим замером (0 для первого)
+    double interval() const {
+        return prev_ns_ > 0 && now_ns_ > prev_ns_ ? (now_ns_ - prev_ns_) / 1e9 : 0.0;
+    }
+
+    // Передаёт width() счётчиков устройства. Возвращает приращения с прошлого
+    // замера или nullptr, если базы ещё нет или устройство отфильтровано.
+    const uint64_t* update(std::string_view key, const uint64_t* counters) {
+        bool added = false;
+        size_t index = find(key, added);
+        Slot &slot = slots_[index];
+        slot.round = round_;
+        if (!slot.accepted) {
+            return nullptr;
+        }
+
+        uint64_t* prev = &values_[index * width_];
+        bool has_base = !added && slot.has_base;
+        bool reset = false;
+        for (size_t i = 0; has_base && i < width_; ++i) {
+            if (counters[i] >= prev[i]) {
+                delta_[i] = counters[i] - prev[i];
+            } else if (wraps_32bit_ && prev[i] <= UINT32_MAX && counters[i] <= UINT32_MAX) {
+                delta_[i] = counters[i] + (uint64_t{1} << 32) - prev[i];
+            } else {
+                reset = true;
+            }
+        }
+
+        std::copy(counters, counters + width_, prev);
+        slot.has_base = true;
+        return has_base && !reset ? delta_.data() : nullptr;
+    }
+
+    // Конец замера: забывает устройства, которых в нём не было
+    void end() {
+        size_t kept = 0;
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].round != round_) {
+                continue;
+            }
+            if (kept != i) {
+                slots_[kept] = std::move(slots_[i]);
+                std::copy(values_.begin() + i * width_, values_.begin() + (i + 1) * width_,
+                          values_.begin() + kept * width_);
+            }
+            ++kept;
+        }
+        if (kept != slots_.size()) {
+            slots_.resize(kept);
+            values_.resize(kept * width_);
+            index_.clear();
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                index_.emplace(slots_[i].key, i);
+            }
+        }
+    }
+
+    // Количество отслеживаемых устройств, включая отфильтрованные
+    size_t devices() const { return slots_.size(); }
+
+private:
+    struct Slot {
+        std::string key;
+        uint64_t round = 0;
+        bool accepted = true;
+        bool has_base = false;
+    };
+
+    size_t find(std::string_view key, bool &added) {
+        if (cursor_ < slots_.size() && slots_[cursor_].key == key) {
+            return cursor_++;
+        }
+        auto it = index_.find(std::string(key));
+        if (it != index_.end()) {
+            cursor_ = it->second + 1;
+            return it->second;
+        }
+
+        added = true;
+        Slot slot;
+        slot.key = std::string(key);
+        slot.accepted = !accept_ || accept_(key);
+        index_.emplace(slot.key, slots_.size());
+        slots_.push_back(std::move(slot));
+        values_.resize(slots_.size() * width_);
+        cursor_ = slots_.size();
+        return slots_.size() - 1;
+    }
+
+    size_t width_;
+    Filter accept_;
+    bool wraps_32bit_;
+    std::vector<Slot> slots_;
+    std::vector<uint64_t> values_;
+    std::vector<uint64_t> delta_;
+    std::unordered_map<std::string, size_t> index_;
+    size_t cursor_ = 0;
+    uint64_t round_ = 0;
+    int64_t now_ns_ = 0;
+    int64_t prev_ns_ = 0;
+};
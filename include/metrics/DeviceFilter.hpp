@@ -0,0 +1,115 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Фильтр имён устройств по шаблонам include/exclude. Шаблоны поддерживают
+// '*' (любая последовательность) и '?' (любой символ) и разбираются один раз
+// при создании. Имя проходит, если подходит под какой-либо include (или
+// include пуст) и не подходит ни под один exclude.
+class DeviceFilter {
+public:
+    DeviceFilter() = default;
+
+    // config - конфигурация метрики с необязательными массивами
+    // "include" и "exclude"
+    explicit DeviceFilter(const nlohmann::json &config) {
+        include_ = compile(config, "include");
+        exclude_ = compile(config, "exclude");
+    }
+
+    bool operator()(std::string_view name) const {
+        if (!include_.empty() && !any_match(include_, name)) {
+            return false;
+        }
+        return !any_match(exclude_, name);
+    }
+
+private:
+    // Шаблон, разбитый по '*': parts[0] привязана к началу, последняя - к концу
+    struct Pattern {
+        std::vector<std::string> parts;
+    };
+
+    static std::vector<Pattern> compile(const nlohmann::json &config, const char* key) {
+        std::vector<Pattern> patterns;
+        if (!config.contains(key)) {
+            return patterns;
+        }
+        if (!config[key].is_array()) {
+            throw std::invalid_argument(std::string("'") + key + "' must be an array of patterns");
+        }
+        for (const auto &item : config[key]) {
+            if (!item.is_string() || item.get<std::string>().empty()) {
+                throw std::invalid_argument(std::string("'") + key +
+                                            "' patterns must be non-empty strings");
+            }
+            Pattern pattern;
+            std::string text = item.get<std::string>();
+            size_t start = 0;
+            while (true) {
+                size_t star = text.find('*', start);
+                pattern.parts.push_back(text.substr(start, star - start));
+                if (star == std::string::npos) {
+                    break;
+                }
+                start = star + 1;
+            }
+            patterns.push_back(std::move(pattern));
+        }
+        return patterns;
+    }
+
+    static bool equal_at(std::string_view name, size_t pos, const std::string &part) {
+        for (size_t i = 0; i < part.size(); ++i) {
+            if (part[i] != '?' && part[i] != name[pos + i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool match(const Pattern &pattern, std::string_view name) {
+        const auto &parts = pattern.parts;
+        const std::string &first = parts.front();
+        if (parts.size() == 1) {
+            return name.size() == first.size() && equal_at(name, 0, first);
+        }
+
+        const std::string &last = parts.back();
+        if (name.size() < first.size() + last.size() || !equal_at(name, 0, first) ||
+            !equal_at(name, name.size() - last.size(), last)) {
+            return false;
+        }
+
+        // Средние части ищем жадно слева направо
+        size_t pos = first.size();
+        size_t limit = name.size() - last.size();
+        for (size_t i = 1; i + 1 < parts.size(); ++i) {
+            const std::string &part = parts[i];
+            while (pos + part.size() <= limit && !equal_at(name, pos, part)) {
+                ++pos;
+            }
+            if (pos + part.size() > limit) {
+                return false;
+            }
+            pos += part.size();
+        }
+        return true;
+    }
+
+    static bool any_match(const std::vector<Pattern> &patterns, std::string_view name) {
+        for (const auto &pattern : patterns) {
+            if (match(pattern, name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Pattern> include_;
+    std::vector<Pattern> exclude_;
+};
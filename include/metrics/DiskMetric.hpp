@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CounterFile.hpp"
+#include "IMetric.hpp"
+
+// Нагрузка на блочные устройства из /proc/diskstats.
+// Для каждого устройства выводит операции и байты в секунду на чтение и
+// запись, среднее время операции в мс и загрузку в процентах (ключи вида
+// "nvme0n1.read_iops"). Устройства отбираются шаблонами include/exclude.
+// Без window_ms первый замер служит базой и значений не содержит.
+class DiskMetric : public IMetric {
+public:
+    explicit DiskMetric(const json &config);
+
+    MetricValue collect() const override;
+    bool is_valid() const override;
+    std::string name() const override;
+    const char* unit(std::string_view key) const override;
+
+private:
+    mutable CounterFile file_;
+};
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <map>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -20,6 +22,20 @@ public:
     virtual bool is_valid() const = 0;
 
     virtual std::string name() const = 0;
+
+    // Единица измерения ряда словаря с ключом key для текстовых выходов
+    // ("MB", "B/s", "%"); пустая строка - без единиц
+    virtual const char* unit(std::string_view key) const {
+        (void)key;
+        return "";
+    }
+
+    // Приёмник внеочередных значений: метрика может передать значение сразу
+    // по событию, не дожидаясь следующего периода. Вызывается из любого потока.
+    using EventCallback = std::function<void(const IMetric*, MetricValue)>;
+
+    // Метрики с событиями переопределяют этот метод, остальные его игнорируют
+    virtual void set_event_callback(EventCallback callback) { (void)callback; }
 };
 
 // Экспортируемые функции для динамической загрузки
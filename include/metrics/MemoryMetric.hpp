@@ -1,16 +1,27 @@
 #pragma once
 
 #include "IMetric.hpp"
+#include "NumaMemory.hpp"
+#include <memory>
+#include <string>
 #include <vector>
 
+// Память из /proc/meminfo. С параметром "numa" выбранные поля дополнительно
+// выводятся по каждому узлу NUMA с ключами вида "node0.MemFree".
 class MemoryMetric : public IMetric {
 public:
     explicit MemoryMetric(const json &config);
+    ~MemoryMetric();
 
     MetricValue collect() const override;
     bool is_valid() const override;
     std::string name() const override;
+    const char* unit(std::string_view key) const override;
 
 private:
     std::vector<std::string> specs_;
+    // /proc/meminfo открыт один раз и перечитывается без выделения памяти
+    int fd_ = -1;
+    mutable std::vector<char> buffer_;
+    std::unique_ptr<NumaMemory> numa_;
 };
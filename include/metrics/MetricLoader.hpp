@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include "IMetric.hpp"
+#include "MetricRegistry.hpp"
 
 class MetricLoader {
 public:
@@ -57,4 +58,23 @@ public:
 
         return std::make_unique<MetricHandle>(handle, metric, destroyFunc);
     }
+
+    // Создание встроенной метрики из реестра (без dlopen)
+    static MetricPtr loadBuiltin(const std::string& type, const json& config) {
+        const MetricRegistry::Entry* entry = MetricRegistry::instance().find(type);
+        if (!entry) {
+            throw std::runtime_error("Unknown built-in metric type: " + type);
+        }
+
+        IMetric* metric = entry->create(config);
+        if (!metric) {
+            throw std::runtime_error("Failed to create metric");
+        }
+
+        return std::make_unique<MetricHandle>(nullptr, metric, entry->destroy);
+    }
+
+    static bool hasBuiltin(const std::string& type) {
+        return MetricRegistry::instance().find(type) != nullptr;
+    }
 };
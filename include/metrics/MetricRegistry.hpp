@@ -0,0 +1,55 @@
+#pragma once
+
+#include "IMetric.hpp"
+#include <map>
+#include <string>
+
+// Реестр встроенных метрик для статической сборки (STATUS_MONITOR_STATIC_METRICS).
+// Метрики, слинкованные в исполняемый файл, регистрируются при статической
+// инициализации и создаются без dlopen.
+class MetricRegistry {
+public:
+    using CreateFunc = IMetric*(*)(const json&);
+    using DestroyFunc = void(*)(IMetric*);
+
+    struct Entry {
+        CreateFunc create;
+        DestroyFunc destroy;
+    };
+
+    static MetricRegistry &instance() {
+        static MetricRegistry registry;
+        return registry;
+    }
+
+    bool add(const std::string &type, CreateFunc create, DestroyFunc destroy) {
+        return entries_.emplace(type, Entry{create, destroy}).second;
+    }
+
+    const Entry* find(const std::string &type) const {
+        auto it = entries_.find(type);
+        return it == entries_.end() ? nullptr : &it->second;
+    }
+
+private:
+    MetricRegistry() = default;
+
+    std::map<std::string, Entry> entries_;
+};
+
+// Объявляет точку входа метрики: в статической сборке регистрирует её
+// в реестре, иначе экспортирует createMetric/destroyMetric для dlopen
+#ifdef STATUS_MONITOR_STATIC_METRICS
+#define STATUS_MONITOR_METRIC(type, Class)                                              \
+    namespace {                                                                         \
+    const bool Class##_registered = MetricRegistry::instance().add(                     \
+        type, [](const json &config) -> IMetric* { return new Class(config); },          \
+        [](IMetric* metric) { delete metric; });                                        \
+    }
+#else
+#define STATUS_MONITOR_METRIC(type, Class)                                              \
+    extern "C" {                                                                        \
+    IMetric* createMetric(const json &config) { return new Class(config); }             \
+    void destroyMetric(IMetric* metric) { delete metric; }                              \
+    }
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IMetric.hpp"
+#include <cstddef>
+#include <string_view>
+
+// Обход значения метрики как набора рядов: скаляр - один ряд, вектор -
+// ряд на элемент, словарь - ряд на ключ в порядке ключей.
+
+// Вызывает f(index, key, value) для каждого ряда; key пуст для скаляров и векторов
+template <typename F>
+void for_each_series(const MetricValue &value, F &&f) {
+    if (std::holds_alternative<int>(value)) {
+        f(size_t{0}, std::string_view(), static_cast<double>(std::get<int>(value)));
+    } else if (std::holds_alternative<double>(value)) {
+        f(size_t{0}, std::string_view(), std::get<double>(value));
+    } else if (std::holds_alternative<std::vector<int>>(value)) {
+        const auto &values = std::get<std::vector<int>>(value);
+        for (size_t i = 0; i < values.size(); ++i) {
+            f(i, std::string_view(), static_cast<double>(values[i]));
+        }
+    } else if (std::holds_alternative<std::vector<double>>(value)) {
+        const auto &values = std::get<std::vector<double>>(value);
+        for (size_t i = 0; i < values.size(); ++i) {
+            f(i, std::string_view(), values[i]);
+        }
+    } else if (std::holds_alternative<std::map<std::string, double>>(value)) {
+        size_t i = 0;
+        for (const auto &[key, v] : std::get<std::map<std::string, double>>(value)) {
+            f(i++, std::string_view(key), v);
+        }
+    }
+}
+
+// Вызывает f(value) для каждого ряда
+template <typename F>
+void for_each_value(const MetricValue &value, F &&f) {
+    for_each_series(value, [&f](size_t, std::string_view, double v) { f(v); });
+}
+
+inline size_t series_count(const MetricValue &value) {
+    if (std::holds_alternative<std::vector<int>>(value)) {
+        return std::get<std::vector<int>>(value).size();
+    }
+    if (std::holds_alternative<std::vector<double>>(value)) {
+        return std::get<std::vector<double>>(value).size();
+    }
+    if (std::holds_alternative<std::map<std::string, double>>(value)) {
+        return std::get<std::map<std::string, double>>(value).size();
+    }
+    return 1;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CounterFile.hpp"
+#include "IMetric.hpp"
+
+// Пропускная способность сетевых интерфейсов из /proc/net/dev.
+// Для каждого интерфейса выводит байты и пакеты в секунду на приём и
+// передачу (ключи вида "eth0.rx_bytes"). Интерфейсы отбираются шаблонами
+// include/exclude. Без window_ms первый замер служит базой и значений
+// не содержит.
+class NetMetric : public IMetric {
+public:
+    explicit NetMetric(const json &config);
+
+    MetricValue collect() const override;
+    bool is_valid() const override;
+    std::string name() const override;
+    const char* unit(std::string_view key) const override;
+
+private:
+    mutable CounterFile file_;
+};
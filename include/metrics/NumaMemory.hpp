@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Память по узлам NUMA из <sysfs>/devices/system/node/node*/{meminfo,numastat}.
+// Узлы находятся один раз при создании, файлы остаются открытыми и
+// перечитываются через pread. Узлы читаются параллельно: каждый поток
+// обрабатывает свою часть узлов и пишет в свои строки плотной таблицы
+// узел × поле. Значения meminfo переводятся из кБ в МБ, счётчики numastat -
+// из страниц в МБ (как в numastat -n). Отсутствующее поле хранится как NaN.
+class NumaMemory {
+public:
+    // fields - поля meminfo, stat_fields - счётчики numastat,
+    // threads - число потоков чтения (0 - по числу узлов, не больше 8)
+    NumaMemory(const std::string &sysfs_root, std::vector<std::string> fields,
+               std::vector<std::string> stat_fields, size_t threads = 0);
+    ~NumaMemory();
+
+    NumaMemory(const NumaMemory &) = delete;
+    NumaMemory &operator=(const NumaMemory &) = delete;
+
+    // Перечитывает все узлы
+    void refresh();
+
+    // Номера найденных узлов по возрастанию
+    const std::vector<int> &nodes() const { return node_ids_; }
+
+    // Поля таблицы: сначала meminfo, затем numastat
+    const std::vector<std::string> &fields() const { return fields_; }
+
+    size_t threads() const { return workers_.size() + 1; }
+
+    double value(size_t node, size_t field) const {
+        return values_[node * fields_.size() + field];
+    }
+
+    // Вся таблица построчно: узел × поле
+    const std::vector<double> &values() const { return values_; }
+
+private:
+    struct Node {
+        int meminfo_fd = -1;
+        int numastat_fd = -1;
+        std::vector<char> buffer;
+    };
+
+    void read_node(size_t index);
+    void read_share(size_t share);
+    void worker_loop(size_t share);
+
+    std::vector<int> node_ids_;
+    std::vector<Node> nodes_;
+    std::vector<std::string> fields_;
+    size_t meminfo_fields_ = 0;
+    std::vector<double> values_;
+    double page_mb_ = 0.0;
+
+    // Раунды чтения: collect() увеличивает round_, потоки отчитываются через pending_
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t round_ = 0;
+    size_t pending_ = 0;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
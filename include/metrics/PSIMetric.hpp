@@ -0,0 +1,64 @@
+#pragma once
+
+#include "IMetric.hpp"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Метрика давления на ресурсы (Pressure Stall Information) из /proc/pressure.
+// Каждый тик выводит средние some/full и суммарное время простоя.
+// Дополнительно может регистрировать триггеры ядра (порог простоя в окне)
+// и при их срабатывании сразу отдавать внеочередное значение. Если PSI или
+// триггеры недоступны, метрика работает как обычный опрос.
+class PSIMetric : public IMetric {
+public:
+    // Открывает дескриптор триггера ресурса resource ("memory") по
+    // спецификации spec ("some 150000 1000000"); -1 - триггер недоступен.
+    // Дескриптор переходит во владение метрики и ждёт POLLPRI.
+    using TriggerOpener =
+        std::function<int(const std::string &resource, const std::string &spec)>;
+
+    explicit PSIMetric(const json &config);
+    // open_trigger подменяет регистрацию в /proc/pressure (например, в тестах)
+    PSIMetric(const json &config, TriggerOpener open_trigger);
+    ~PSIMetric();
+
+    MetricValue collect() const override;
+    bool is_valid() const override;
+    std::string name() const override;
+    const char* unit(std::string_view key) const override;
+    void set_event_callback(EventCallback callback) override;
+
+    // Количество успешно зарегистрированных триггеров
+    size_t active_triggers() const;
+
+private:
+    struct Resource {
+        std::string name;
+        int fd = -1;
+    };
+
+    struct Trigger {
+        size_t resource;
+        std::string type;
+        uint64_t stall_us;
+        uint64_t window_us;
+        int fd = -1;
+    };
+
+    void read_resource(const Resource &resource, std::map<std::string, double> &out) const;
+    void register_trigger(Trigger &trigger);
+    void watch_triggers();
+
+    std::string proc_root_ = "/proc";
+    TriggerOpener open_trigger_;
+    std::vector<Resource> resources_;
+    std::vector<Trigger> triggers_;
+
+    std::mutex callback_mutex_;
+    EventCallback callback_;
+    int wake_fd_ = -1;
+    std::thread watcher_;
+};
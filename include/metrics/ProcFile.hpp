@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <sys/types.h>
+#include <unistd.h>
+#include <vector>
+
+// Вспомогательные функции разбора файлов procfs без выделения памяти
+namespace procfile {
+
+// Читает файл целиком с начала в buffer, при нехватке места увеличивает его.
+// Возвращает размер прочитанного или -1.
+inline ssize_t read_all(int fd, std::vector<char> &buffer) {
+    while (true) {
+        ssize_t size = pread(fd, buffer.data(), buffer.size(), 0);
+        if (size < 0 || static_cast<size_t>(size) < buffer.size()) {
+            return size;
+        }
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+inline const char* skip_spaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    return p;
+}
+
+// Пропускает слово до пробела, табуляции или конца строки
+inline const char* skip_word(const char* p, const char* end) {
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\n') {
+        ++p;
+    }
+    return p;
+}
+
+// Разбирает беззнаковое число, пропуская пробелы; сдвигает p за число
+inline uint64_t parse_u64(const char*& p, const char* end) {
+    p = skip_spaces(p, end);
+    uint64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+} // namespace procfile
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Потоковый накопитель статистики загрузки в процентах (0..100).
+// Размер фиксирован: min/max/сумма и гистограмма для перцентилей,
+// добавление значения не выделяет память.
+class UsageAccumulator {
+public:
+    // Разрешение гистограммы - 0.5%
+    static constexpr int kBins = 200;
+
+    UsageAccumulator() { reset(); }
+
+    void add(double value) {
+        value = std::clamp(value, 0.0, 100.0);
+        int bin = static_cast<int>(value * kBins / 100.0);
+        ++bins_[bin < kBins ? bin : kBins - 1];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void reset() {
+        std::fill(bins_, bins_ + kBins, 0u);
+        count_ = 0;
+        sum_ = 0.0;
+        min_ = std::numeric_limits<double>::infinity();
+        max_ = -std::numeric_limits<double>::infinity();
+    }
+
+    uint32_t count() const { return count_; }
+    double min() const { return count_ ? min_ : 0.0; }
+    double max() const { return count_ ? max_ : 0.0; }
+    double mean() const { return count_ ? sum_ / count_ : 0.0; }
+
+    // Перцентиль q (0..1) с точностью до ширины корзины
+    double percentile(double q) const {
+        if (count_ == 0) {
+            return 0.0;
+        }
+        uint64_t rank = static_cast<uint64_t>(q * count_ + 0.999999);
+        rank = std::clamp<uint64_t>(rank, 1, count_);
+
+        uint64_t seen = 0;
+        for (int bin = 0; bin < kBins; ++bin) {
+            seen += bins_[bin];
+            if (seen >= rank) {
+                // Верхняя граница корзины, но не за пределами наблюдений
+                double upper = (bin + 1) * 100.0 / kBins;
+                return std::clamp(upper, min_, max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    uint32_t bins_[kBins];
+    uint32_t count_;
+    double sum_;
+    double min_;
+    double max_;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "metrics/IMetric.hpp"
+#include "net/Socket.hpp"
+#include "net/StreamProtocol.hpp"
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Роль агрегатора: принимает соединения агентов через epoll и сводит их
+// потоки в ряды по узлам. Значения узла выдаются как метрики с именем
+// "узел/метрика" и передаются обычным выходам.
+class Aggregator {
+public:
+    // config - объект settings: {"listen": "tcp://0.0.0.0:9100", "max_connections": 4096}
+    explicit Aggregator(const json &config);
+    ~Aggregator();
+
+    Aggregator(const Aggregator &) = delete;
+    Aggregator &operator=(const Aggregator &) = delete;
+
+    // Обрабатывает сетевые события, ожидая не дольше timeout_ms
+    void poll(int timeout_ms);
+
+    // Последние значения узлов, обновлённых с прошлого вызова
+    std::vector<std::pair<const IMetric*, MetricValue>> collect();
+
+    const Endpoint &endpoint() const { return endpoint_; }
+    size_t connection_count() const { return connections_.size(); }
+    size_t node_count() const { return nodes_.size(); }
+
+private:
+    struct Connection {
+        FrameDecoder decoder;
+        std::string node;
+        bool has_schema = false;
+        StreamSchema schema;
+        std::vector<const IMetric*> metrics;
+    };
+
+    struct Node {
+        // Метрики узла живут до конца работы, чтобы указатели у выходов
+        // оставались действительными при переподключениях
+        std::map<std::string, std::unique_ptr<IMetric>> metrics;
+        std::vector<std::pair<const IMetric*, MetricValue>> values;
+        uint64_t timestamp_ms = 0;
+        bool updated = false;
+    };
+
+    void accept_connections();
+    void read_connection(int fd);
+    void handle_frame(Connection &connection, const FrameDecoder::Frame &frame);
+    void close_connection(int fd);
+
+    Endpoint endpoint_;
+    size_t max_connections_ = 4096;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+
+    std::unordered_map<int, Connection> connections_;
+    std::map<std::string, Node> nodes_;
+    std::vector<double> scratch_;
+    std::vector<char> read_buffer_;
+};
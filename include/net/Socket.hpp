@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Адрес для потоковых соединений: "tcp://host:port" или "unix:/path"
+struct Endpoint {
+    enum class Family {
+        Tcp,
+        Unix,
+    };
+
+    Family family = Family::Tcp;
+    std::string host;
+    uint16_t port = 0;
+    std::string path;
+
+    // Бросает std::invalid_argument при некорректном адресе
+    static Endpoint parse(const std::string &address);
+
+    std::string to_string() const;
+};
+
+// Неблокирующее подключение. Возвращает дескриптор (подключение может быть
+// ещё в процессе) или -1 при ошибке.
+int connect_endpoint(const Endpoint &endpoint);
+
+// Проверяет завершение неблокирующего подключения: 1 - подключено,
+// 0 - ещё в процессе, -1 - ошибка
+int check_connected(int fd);
+
+// Неблокирующий слушающий сокет. Бросает std::runtime_error при ошибке.
+int listen_endpoint(const Endpoint &endpoint, int backlog);
+
+// Фактический адрес слушающего сокета (например, после bind на порт 0)
+Endpoint bound_endpoint(int fd, const Endpoint &endpoint);
+
+bool set_nonblocking(int fd);
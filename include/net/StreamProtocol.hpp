@@ -0,0 +1,92 @@
+#pragma once
+
+#include "metrics/IMetric.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Компактный бинарный протокол передачи тиков от агента к агрегатору.
+//
+// Кадр: [u32 длина нагрузки][u8 тип][нагрузка], все числа little-endian.
+//   Hello  - u16 версия, строка с именем узла
+//   Schema - u16 число метрик, для каждой: строка имени, u8 вид, u32 число
+//            рядов, для словарей - строки ключей
+//   Values - u64 время (мс), u32 число рядов, значения double
+// Строка кодируется как u16 длина + байты. Схема передаётся один раз после
+// подключения и повторно только при её изменении, далее идут только Values.
+
+enum class FrameType : uint8_t {
+    Hello = 1,
+    Schema = 2,
+    Values = 3,
+};
+
+// Описание рядов тика: имена метрик, их вид и ключи словарей
+struct StreamSchema {
+    enum class Kind : uint8_t {
+        Scalar = 0,
+        Vector = 1,
+        Map = 2,
+    };
+
+    struct Entry {
+        std::string name;
+        Kind kind = Kind::Scalar;
+        uint32_t count = 0;
+        std::vector<std::string> keys;
+        // Метрика, по которой построена запись (не передаётся по сети):
+        // пока объект тот же, имя в matches() не запрашивается
+        const IMetric* metric = nullptr;
+    };
+
+    std::vector<Entry> entries;
+
+    static StreamSchema from(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values);
+
+    // Совпадает ли схема с формой значений. Для тех же объектов метрик
+    // память не выделяется; имя запрашивается только у другой метрики.
+    bool matches(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) const;
+
+    uint64_t series_count() const;
+
+    // Собирает значения метрик из плоского массива рядов
+    std::vector<MetricValue> unpack(const std::vector<double> &values) const;
+};
+
+class StreamProtocol {
+public:
+    static constexpr uint16_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 5;
+    static constexpr uint32_t kMaxPayload = 16 * 1024 * 1024;
+
+    // Кодирование кадров: дописывают кадр в конец out
+    static void encode_hello(std::string &out, std::string_view node);
+    static void encode_schema(std::string &out, const StreamSchema &schema);
+    static void encode_values(std::string &out, uint64_t timestamp_ms,
+                              const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values);
+
+    // Декодирование нагрузки; при некорректных данных бросают std::runtime_error
+    static std::string decode_hello(std::string_view payload);
+    static StreamSchema decode_schema(std::string_view payload);
+    static uint64_t decode_values(std::string_view payload, std::vector<double> &values);
+};
+
+// Разбивает поток байт соединения на кадры
+class FrameDecoder {
+public:
+    struct Frame {
+        FrameType type;
+        std::string_view payload;
+    };
+
+    void feed(const char* data, size_t size);
+
+    // Извлекает очередной полный кадр. payload действителен до следующего
+    // вызова feed/next. Бросает std::runtime_error при нарушении протокола.
+    bool next(Frame &frame);
+
+private:
+    std::string buffer_;
+    size_t offset_ = 0;
+};
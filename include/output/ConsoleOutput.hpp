@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Deadband.hpp"
+#include "core/TimestampFormatter.hpp"
 #include "IOutput.hpp"
 #include <nlohmann/json.hpp>
 
@@ -7,9 +9,14 @@ class ConsoleOutput : public IOutput {
 public:
     explicit ConsoleOutput(const json &config);
 
-    void write(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
+    using IOutput::write;
+    void write(const Timestamp &tick,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
     bool is_valid() const override;
 
 private:
     void print_metric(const IMetric* metric, const MetricValue &value) const;
+
+    Deadband deadband_;
+    TimestampFormatter formatter_;
 };
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "metrics/IMetric.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Режим вывода только изменений (deadband).
+// Ряд выводится, если его значение сдвинулось больше чем на абсолютный
+// или относительный порог, либо с момента последнего вывода прошло
+// больше heartbeat секунд. Первое значение ряда выводится всегда.
+// Ряды словарей отслеживаются по ключу, векторов - по индексу, поэтому
+// появление и исчезновение ключей (интерфейсы, диски, узлы NUMA) не
+// сбивает состояние остальных рядов.
+class Deadband {
+public:
+    Deadband() = default;
+
+    // config - объект "deadband" из конфигурации выхода:
+    // {"abs": 0.5, "rel": 0.01, "heartbeat": 60}
+    explicit Deadband(const json &config);
+
+    bool enabled() const { return enabled_; }
+
+    // Оценивает все ряды тика на момент monotonic_ns и запоминает, какие
+    // из них нужно вывести. Возвращает общее количество рядов для вывода.
+    size_t evaluate(int64_t monotonic_ns,
+                    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values);
+
+    // Нужно ли выводить ряд index (позиция в значении тика) метрики в текущем тике
+    bool emitted(const IMetric* metric, size_t index) const;
+
+    // Количество рядов метрики, выводимых в текущем тике
+    size_t emitted_count(const IMetric* metric) const;
+
+    // Последнее выведенное значение ряда index метрики; value - текущее
+    // значение ряда, оно возвращается, если режим выключен или ряд неизвестен.
+    // Нужно выходам, которые перерисовывают все ряды целиком.
+    double shown(const IMetric* metric, size_t index, double value) const;
+
+private:
+    // Компактное состояние одного ряда
+    struct SeriesState {
+        double last = 0.0;
+        int64_t last_emit_ns = 0;
+        uint64_t round = 0;
+        bool seen = false;
+    };
+
+    struct MetricState {
+        // Состояние рядов скаляров и векторов по индексу
+        std::vector<SeriesState> indexed;
+        // Состояние рядов словарей по ключу
+        std::map<std::string, SeriesState, std::less<>> keyed;
+        // Решения текущего тика по позиции ряда
+        std::vector<char> emit;
+        // Последние выведенные значения по позиции ряда
+        std::vector<double> shown;
+        size_t emitted = 0;
+    };
+
+    size_t update(const IMetric* metric, const MetricValue &value);
+    bool pass(SeriesState &state, double value) const;
+
+    bool enabled_ = false;
+    double abs_eps_ = 0.0;
+    double rel_eps_ = 0.0;
+    int64_t heartbeat_ns_ = 0;
+    int64_t now_ns_ = 0;
+    uint64_t round_ = 0;
+
+    std::unordered_map<const IMetric*, MetricState> metrics_;
+};
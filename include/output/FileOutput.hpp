@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Deadband.hpp"
+#include "core/TimestampFormatter.hpp"
 #include "IOutput.hpp"
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -10,11 +12,15 @@ public:
     explicit FileOutput(const json &config);
     ~FileOutput();
 
-    void write(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
+    using IOutput::write;
+    void write(const Timestamp &tick,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
     bool is_valid() const override;
 
 private:
     std::string file_path_;
     std::ofstream file_;
+    Deadband deadband_;
+    TimestampFormatter formatter_;
     void write_metric(const IMetric* metric, const MetricValue &value);
 };
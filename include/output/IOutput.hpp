@@ -1,17 +1,41 @@
 #pragma once
 
+#include "core/Timestamp.hpp"
 #include "metrics/IMetric.hpp"
 #include <memory>
 #include <string>
 #include <vector>
 
+// Суффикс единицы ряда (IMetric::unit) для текстовых выходов: " MB" или пусто
+inline std::string unit_suffix(const char* unit) {
+    return *unit ? std::string(" ") + unit : std::string();
+}
+
 class IOutput {
 public:
     virtual ~IOutput() = default;
 
-    // Вывод метрик с уже вычисленными значениями
-    virtual void write(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) = 0;
+    // Вывод метрик с уже вычисленными значениями на момент тика
+    virtual void write(const Timestamp &tick, const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) = 0;
+
+    // Вывод с отметкой текущего момента
+    void write(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+        write(Timestamp::now(), metric_values);
+    }
+
+    // Внеочередное значение одной метрики между тиками. Это не тик: выходы
+    // со схемой, экраном или deadband не должны принимать его за полный
+    // набор метрик. По умолчанию событие пропускается, а значение метрики
+    // попадёт в следующий тик.
+    virtual void write_event(const Timestamp &tick, const IMetric* metric, const MetricValue &value) {
+        (void)tick;
+        (void)metric;
+        (void)value;
+    }
 
     // Проверка валидности конфигурации
     virtual bool is_valid() const = 0;
+
+    // Завершение работы: дописать накопленные данные перед выходом
+    virtual void finish() {}
 };
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Потоковый сериализатор JSON в переиспользуемый буфер.
+// Не строит промежуточный DOM: после прогрева буфера запись
+// очередного объекта не выделяет память.
+class JsonWriter {
+public:
+    explicit JsonWriter(size_t reserve = 4096);
+
+    // Сбрасывает содержимое, сохраняя выделенную память
+    void clear();
+
+    const char* data() const { return buffer_.data(); }
+    size_t size() const { return buffer_.size(); }
+    std::string_view view() const { return buffer_; }
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    void key(std::string_view name);
+
+    void value(double number);
+    void value(int64_t number);
+    void value(int number) { value(static_cast<int64_t>(number)); }
+    void value(std::string_view text);
+    void boolean(bool flag);
+    void null();
+
+    // Произвольный символ вне структуры (например, перевод строки для JSONL)
+    void raw(char c) { buffer_.push_back(c); }
+
+private:
+    static constexpr int kMaxDepth = 32;
+
+    void separator();
+    void open(char c);
+    void close(char c);
+    void escape(std::string_view text);
+
+    std::string buffer_;
+
+    // Для каждого уровня вложенности: был ли уже записан элемент
+    bool has_items_[kMaxDepth] = {};
+    int depth_ = 0;
+    bool after_key_ = false;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "IOutput.hpp"
+#include "JsonWriter.hpp"
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+// Вывод в формате JSON Lines: одна строка-объект на каждый тик
+class JsonlOutput : public IOutput {
+public:
+    explicit JsonlOutput(const json &config);
+    ~JsonlOutput();
+
+    using IOutput::write;
+    void write(const Timestamp &tick,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
+    // Событие выводится отдельной строкой только с этой метрикой
+    // и полем "event": true, чтобы отличать его от строк тиков
+    void write_event(const Timestamp &tick, const IMetric* metric, const MetricValue &value) override;
+    bool is_valid() const override;
+
+    // Ключи метрик в строке JSON. Имена запрашиваются у метрик только при
+    // смене их набора, а не на каждом тике. Повторяющиеся имена и имена,
+    // совпадающие со служебными полями "timestamp" и "event", получают
+    // суффикс "#2", "#3"..., чтобы в объекте не было одинаковых ключей.
+    class MetricKeys {
+    public:
+        const std::vector<std::string> &
+        update(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values);
+
+        // Ключ метрики из последнего набора или её имя, если её там нет
+        std::string key_of(const IMetric* metric) const;
+
+    private:
+        std::vector<const IMetric*> metrics_;
+        std::vector<std::string> keys_;
+    };
+
+    // Сериализует тик в writer (без перевода строки); event добавляет
+    // поле "event": true для внеочередных значений, их ключи берутся из
+    // набора тиков и его не меняют
+    static void serialize(JsonWriter &writer, int64_t timestamp_ms,
+                          const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values,
+                          MetricKeys &keys, bool event = false);
+
+private:
+    void write_line(const Timestamp &tick,
+                    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values,
+                    bool event);
+
+    std::string file_path_;
+    std::ofstream file_;
+    JsonWriter writer_;
+    MetricKeys keys_;
+};
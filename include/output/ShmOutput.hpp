@@ -0,0 +1,50 @@
+#pragma once
+
+#include "IOutput.hpp"
+#include "net/StreamProtocol.hpp"
+#include "shm/SnapshotReader.hpp"
+#include <nlohmann/json.hpp>
+#include <string>
+
+// Публикует каждый тик в сегмент разделяемой памяти POSIX.
+// Раскладка сегмента фиксирована (см. shm/SnapshotReader.hpp): заголовок,
+// схема из имён рядов и массив значений double. Запись защищена seqlock,
+// поэтому локальные потребители читают снимок без системных вызовов
+// и блокировок, а писатель никогда их не ждёт.
+class ShmOutput : public IOutput {
+public:
+    explicit ShmOutput(const json &config);
+    ~ShmOutput();
+
+    ShmOutput(const ShmOutput &) = delete;
+    ShmOutput &operator=(const ShmOutput &) = delete;
+
+    using IOutput::write;
+    void write(const Timestamp &tick,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
+    // Обновляет на месте ряды метрики из текущей схемы, остальные ряды и
+    // схема не меняются. Ключи словаря, которых нет в схеме, пропускаются.
+    void write_event(const Timestamp &tick, const IMetric* metric, const MetricValue &value) override;
+    bool is_valid() const override;
+
+    const std::string &name() const { return name_; }
+    uint32_t capacity() const { return capacity_; }
+    // Количество рядов, не поместившихся в сегмент
+    uint64_t truncated_series() const { return truncated_series_; }
+
+private:
+    void publish_schema();
+
+    std::string name_;
+    uint32_t capacity_ = 1024;
+    bool unlink_ = true;
+
+    shm_snapshot::Header* header_ = nullptr;
+    shm_snapshot::Series* series_ = nullptr;
+    double* values_ = nullptr;
+    size_t size_ = 0;
+
+    StreamSchema schema_;
+    bool has_schema_ = false;
+    uint64_t truncated_series_ = 0;
+};
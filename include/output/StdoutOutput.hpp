@@ -0,0 +1,53 @@
+#pragma once
+
+#include "IOutput.hpp"
+#include "JsonWriter.hpp"
+#include "JsonlOutput.hpp"
+#include <nlohmann/json.hpp>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+
+// Машиночитаемый вывод в stdout для сценариев и проверок (флаг --format).
+//   jsonl      - одна строка JSON на тик, как у выхода "jsonl"
+//   prometheus - текстовый формат Prometheus: ряд на строку с меткой
+//                времени, векторы с меткой index, словари с меткой key;
+//                # TYPE выводится один раз на семейство
+// Внеочередные значения метрик выводятся отдельными строками: в jsonl с
+// полем "event": true, в prometheus с меткой event="true".
+// Каждый тик сбрасывается в поток сразу после записи.
+class StdoutOutput : public IOutput {
+public:
+    enum class Format {
+        Jsonl,
+        Prometheus,
+    };
+
+    explicit StdoutOutput(const json &config);
+    StdoutOutput(const json &config, std::ostream &out);
+
+    using IOutput::write;
+    void write(const Timestamp &tick,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
+    // Событие выводится отдельной строкой только с этой метрикой
+    void write_event(const Timestamp &tick, const IMetric* metric, const MetricValue &value) override;
+    bool is_valid() const override;
+    void finish() override;
+
+    Format format() const { return format_; }
+
+private:
+    void write_lines(const Timestamp &tick,
+                     const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values,
+                     bool event);
+    void write_prometheus(int64_t timestamp_ms, const IMetric* metric, const MetricValue &value,
+                          bool event);
+
+    std::ostream &out_;
+    Format format_ = Format::Jsonl;
+    JsonWriter writer_;
+    JsonlOutput::MetricKeys keys_;
+    std::string line_;
+    // Семейства Prometheus, для которых уже выведена строка # TYPE
+    std::unordered_set<std::string> typed_;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "IOutput.hpp"
+#include "net/Socket.hpp"
+#include "net/StreamProtocol.hpp"
+#include <chrono>
+#include <deque>
+#include <nlohmann/json.hpp>
+#include <string>
+
+// Роль агента: отправляет тики агрегатору по бинарному протоколу.
+// Запись никогда не блокирует основной цикл: пока соединения нет,
+// кадры копятся в ограниченном буфере, при переполнении старые значения
+// отбрасываются. Переподключение выполняется с экспоненциальной задержкой.
+class StreamOutput : public IOutput {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto kFinishTimeout = std::chrono::seconds(2);
+
+    explicit StreamOutput(const json &config);
+    ~StreamOutput();
+
+    using IOutput::write;
+    void write(const Timestamp &tick,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) override;
+    bool is_valid() const override;
+
+    // Ждёт отправки накопленных кадров не дольше kFinishTimeout
+    void finish() override;
+
+    // Отправляет накопленные кадры без блокировки. Возвращает true,
+    // если буфер полностью отправлен.
+    bool flush();
+
+    bool connected() const { return fd_ >= 0 && !connecting_; }
+    size_t buffered_bytes() const { return pending_bytes_; }
+    uint64_t dropped_frames() const { return dropped_frames_; }
+
+private:
+    void try_connect();
+    void disconnect();
+    void on_connected();
+    void enqueue(const std::string &frame);
+    void drop_stale_values();
+
+    Endpoint endpoint_;
+    bool valid_ = false;
+    std::string node_;
+    size_t max_buffer_ = 1024 * 1024;
+
+    int fd_ = -1;
+    bool connecting_ = false;
+    Clock::time_point next_attempt_{};
+    Clock::duration backoff_{};
+
+    // Очередь кадров; первый может быть отправлен частично
+    std::deque<std::string> pending_;
+    size_t pending_bytes_ = 0;
+    size_t sent_offset_ = 0;
+
+    StreamSchema schema_;
+    bool has_schema_ = false;
+    std::string frame_;
+    uint64_t dropped_frames_ = 0;
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+// Читатель снимка метрик из разделяемой памяти (выход "shm").
+// Самодостаточный заголовочный файл без зависимостей от остального проекта:
+// его можно скопировать в приложение-потребитель.
+//
+// После open() чтение снимка не делает системных вызовов и не берёт
+// блокировок: согласованность обеспечивает seqlock в заголовке сегмента.
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace shm_snapshot {
+
+constexpr uint32_t kMagic = 0x534d4f4e;  // "SMON"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kNameSize = 64;
+
+// Раскладка сегмента: Header, затем Series[capacity], затем double[capacity]
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    // Нечётное значение - идёт запись
+    std::atomic<uint64_t> sequence;
+    // Меняется при изменении набора рядов
+    uint64_t schema_generation;
+    int64_t realtime_ns;
+    int64_t monotonic_ns;
+    uint32_t capacity;
+    uint32_t count;
+    uint64_t schema_offset;
+    uint64_t values_offset;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "seqlock requires lock-free 64-bit atomics");
+
+// Имя ряда: "метрика/ключ" или "метрика/индекс"
+struct Series {
+    char name[kNameSize];
+};
+
+inline size_t segment_size(uint32_t capacity) {
+    return sizeof(Header) + capacity * (sizeof(Series) + sizeof(double));
+}
+
+struct Snapshot {
+    uint64_t sequence = 0;
+    uint64_t schema_generation = 0;
+    int64_t realtime_ns = 0;
+    int64_t monotonic_ns = 0;
+    std::vector<std::string> names;
+    std::vector<double> values;
+
+    // Индекс ряда по имени или -1
+    int find(const std::string &name) const {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader() = default;
+    explicit SnapshotReader(const std::string &name) { open(name); }
+    ~SnapshotReader() { close(); }
+
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+    bool open(const std::string &name) {
+        close();
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+
+        header_ = static_cast<const Header*>(data);
+        size_ = static_cast<size_t>(st.st_size);
+        if (header_->magic != kMagic || header_->version != kVersion ||
+            segment_size(header_->capacity) > size_) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (header_) {
+            munmap(const_cast<Header*>(header_), size_);
+            header_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    bool is_open() const { return header_ != nullptr; }
+
+    // Читает согласованный снимок. Память выделяется только при первом
+    // чтении и при смене набора рядов. Возвращает false, если за max_retries
+    // попыток писатель так и не дал прочитать снимок целиком, или если
+    // раскладка сегмента вышла за пределы отображения (писатель перезапущен
+    // с другой ёмкостью) - тогда сегмент нужно открыть заново.
+    bool read(Snapshot &snapshot, int max_retries = 1000) const {
+        if (!header_) {
+            return false;
+        }
+        const char* base = reinterpret_cast<const char*>(header_);
+
+        for (int attempt = 0; attempt < max_retries; ++attempt) {
+            uint64_t begin = header_->sequence.load(std::memory_order_acquire);
+            if (begin & 1) {
+                continue;
+            }
+
+            uint32_t count = header_->count;
+            if (count > header_->capacity) {
+                continue;
+            }
+            // Смещения берутся из общей памяти и проверяются по своему отображению
+            uint64_t values_offset = header_->values_offset;
+            uint64_t schema_offset = header_->schema_offset;
+            if (values_offset > size_ || (size_ - values_offset) / sizeof(double) < count ||
+                schema_offset > size_ || (size_ - schema_offset) / sizeof(Series) < count) {
+                return false;
+            }
+            uint64_t generation = header_->schema_generation;
+            int64_t realtime_ns = header_->realtime_ns;
+            int64_t monotonic_ns = header_->monotonic_ns;
+
+            snapshot.values.resize(count);
+            std::memcpy(snapshot.values.data(), base + values_offset,
+                        count * sizeof(double));
+
+            bool schema_changed = generation != snapshot.schema_generation ||
+                                  snapshot.names.size() != count;
+            if (schema_changed) {
+                const auto* series = reinterpret_cast<const Series*>(base + schema_offset);
+                snapshot.names.resize(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    snapshot.names[i].assign(series[i].name,
+                                             strnlen(series[i].name, kNameSize));
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header_->sequence.load(std::memory_order_relaxed) != begin) {
+                continue;
+            }
+
+            snapshot.sequence = begin;
+            snapshot.schema_generation = generation;
+            snapshot.realtime_ns = realtime_ns;
+            snapshot.monotonic_ns = monotonic_ns;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    const Header* header_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace shm_snapshot
@@ -0,0 +1,148 @@
+#include "core/CommandLine.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+// Встроенные метрики, которые понимают window_ms
+const char* const kWindowedMetrics[] = {"cpu", "net", "disk"};
+
+// Встроенная метрика: известный тип без библиотеки или со своей
+// библиотекой из сборки ("./net_metric.so")
+bool is_windowed_metric(const nlohmann::json &metric) {
+    if (!metric.is_object() || !metric.contains("type") || !metric["type"].is_string()) {
+        return false;
+    }
+    std::string type = metric["type"].get<std::string>();
+    bool known = false;
+    for (const char* name : kWindowedMetrics) {
+        known = known || type == name;
+    }
+    if (!known || !metric.contains("library")) {
+        return known;
+    }
+    if (!metric["library"].is_string()) {
+        return false;
+    }
+    std::string library = metric["library"].get<std::string>();
+    std::string file = library.substr(library.find_last_of('/') + 1);
+    return file == type + "_metric.so";
+}
+
+// Значение флага: "--flag value" или "--flag=value"
+bool take_value(const std::string &arg, const std::string &flag, int argc,
+                const char* const argv[], int &i, std::string &value) {
+    if (arg == flag) {
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Option " + flag + " requires a value");
+        }
+        value = argv[++i];
+        return true;
+    }
+    if (arg.compare(0, flag.size() + 1, flag + "=") == 0) {
+        value = arg.substr(flag.size() + 1);
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+CommandLine CommandLine::parse(int argc, const char* const argv[]) {
+    CommandLine options;
+    bool once = false;
+    std::string value;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verbose" || arg == "-v") {
+            options.verbose = true;
+        } else if (arg == "--startup-profile") {
+            options.startup_profile = true;
+        } else if (arg == "--once") {
+            once = true;
+        } else if (take_value(arg, "--count", argc, argv, i, value)) {
+            char* end = nullptr;
+            long long count = std::strtoll(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || count <= 0) {
+                throw std::invalid_argument("--count must be a positive integer");
+            }
+            options.count = count;
+        } else if (take_value(arg, "--duration", argc, argv, i, value)) {
+            options.duration_ms = parse_duration_ms(value);
+        } else if (take_value(arg, "--window", argc, argv, i, value)) {
+            options.window_ms = parse_duration_ms(value);
+        } else if (take_value(arg, "--format", argc, argv, i, value)) {
+            if (value != "jsonl" && value != "prometheus") {
+                throw std::invalid_argument("--format must be 'jsonl' or 'prometheus'");
+            }
+            options.format = value;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            throw std::invalid_argument("Unknown option: " + arg);
+        } else if (options.config_path.empty()) {
+            options.config_path = arg;
+        } else {
+            throw std::invalid_argument("Unexpected argument: " + arg);
+        }
+    }
+
+    if (options.config_path.empty()) {
+        throw std::invalid_argument("Config file is required");
+    }
+    if (once) {
+        if (options.count > 0) {
+            throw std::invalid_argument("--once and --count are mutually exclusive");
+        }
+        options.count = 1;
+        if (options.window_ms == 0) {
+            options.window_ms = kOnceWindowMs;
+        }
+    }
+    return options;
+}
+
+int64_t CommandLine::parse_duration_ms(const std::string &text) {
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    std::string suffix = end ? end : "";
+    double scale = 0.0;
+    if (suffix.empty() || suffix == "s") {
+        scale = 1000.0;
+    } else if (suffix == "ms") {
+        scale = 1.0;
+    } else if (suffix == "m") {
+        scale = 60000.0;
+    } else if (suffix == "h") {
+        scale = 3600000.0;
+    }
+
+    if (text.empty() || end == text.c_str() || scale == 0.0 || !std::isfinite(value) ||
+        value * scale < 1.0) {
+        throw std::invalid_argument("Invalid duration '" + text +
+                                    "': expected e.g. 250ms, 10s, 5m or 1h");
+    }
+    return static_cast<int64_t>(std::llround(value * scale));
+}
+
+void CommandLine::apply_window(nlohmann::json &config) const {
+    if (window_ms <= 0 || !config.contains("metrics") || !config["metrics"].is_array()) {
+        return;
+    }
+    for (auto &metric : config["metrics"]) {
+        if (!is_windowed_metric(metric)) {
+            continue;
+        }
+        if (!metric.contains("config")) {
+            metric["config"] = nlohmann::json::object();
+        }
+        if (metric["config"].is_object() && !metric["config"].contains("window_ms")) {
+            metric["config"]["window_ms"] = window_ms;
+        }
+    }
+}
+
+std::string CommandLine::usage(const std::string &program) {
+    return "Usage: " + program +
+           " [--verbose] [--startup-profile] [--once | --count N] [--duration T]"
+           " [--window T] [--format jsonl|prometheus] <config_file>";
+}
@@ -0,0 +1,166 @@
+#include "core/ConfigValidator.hpp"
+#include "metrics/MetricRegistry.hpp"
+#include <map>
+
+namespace {
+
+// Обязательные строковые поля выходов: достаточно любого из списка
+const std::map<std::string, std::vector<std::string>> kOutputFields = {
+    {"console", {}},
+    {"file", {"file", "path"}},
+    {"jsonl", {"path"}},
+    {"stream", {"address"}},
+    {"shm", {"name"}},
+};
+
+bool is_string(const json &object, const char* key) {
+    return object.contains(key) && object[key].is_string() &&
+           !object[key].get<std::string>().empty();
+}
+
+class Validator {
+public:
+    Validator(const json &config, bool require_outputs)
+        : config_(config), require_outputs_(require_outputs) {}
+
+    std::vector<std::string> run() {
+        if (!config_.is_object()) {
+            error("config", "must be a JSON object");
+            return errors_;
+        }
+
+        std::string role = "agent";
+        if (!config_.contains("settings") || !config_["settings"].is_object()) {
+            error("settings", "must be an object with 'period'");
+        } else {
+            role = settings(config_["settings"]);
+        }
+
+        if (role == "agent") {
+            metrics();
+        }
+        outputs();
+        return errors_;
+    }
+
+private:
+    void error(const std::string &path, const std::string &message) {
+        errors_.push_back(path + ": " + message);
+    }
+
+    std::string settings(const json &settings) {
+        if (!settings.contains("period") || !settings["period"].is_number_integer() ||
+            settings["period"].get<long long>() <= 0) {
+            error("settings.period", "must be a positive integer");
+        }
+        if (settings.contains("verbose") && !settings["verbose"].is_boolean()) {
+            error("settings.verbose", "must be a boolean");
+        }
+        if (settings.contains("governor") && !settings["governor"].is_object()) {
+            error("settings.governor", "must be an object");
+        }
+
+        std::string role = "agent";
+        if (settings.contains("role")) {
+            if (!settings["role"].is_string() ||
+                (settings["role"] != "agent" && settings["role"] != "aggregator")) {
+                error("settings.role", "must be 'agent' or 'aggregator'");
+                return "";
+            }
+            role = settings["role"].get<std::string>();
+        }
+        if (role == "aggregator" && !is_string(settings, "listen")) {
+            error("settings.listen", "aggregator requires a listen address");
+        }
+        return role;
+    }
+
+    void metrics() {
+        if (!config_.contains("metrics") || !config_["metrics"].is_array() ||
+            config_["metrics"].empty()) {
+            error("metrics", "must be a non-empty array");
+            return;
+        }
+
+        for (size_t i = 0; i < config_["metrics"].size(); ++i) {
+            const json &metric = config_["metrics"][i];
+            std::string path = "metrics[" + std::to_string(i) + "]";
+            if (!metric.is_object()) {
+                error(path, "must be an object");
+                continue;
+            }
+            if (!is_string(metric, "type")) {
+                error(path + ".type", "must be a non-empty string");
+            }
+            if (metric.contains("library")) {
+                if (!is_string(metric, "library")) {
+                    error(path + ".library", "must be a non-empty string");
+                }
+            } else if (is_string(metric, "type") &&
+                       !MetricRegistry::instance().find(metric["type"].get<std::string>())) {
+                error(path + ".library", "required: metric '" +
+                                             metric["type"].get<std::string>() +
+                                             "' is not built in");
+            }
+            if (metric.contains("config") && !metric["config"].is_object()) {
+                error(path + ".config", "must be an object");
+            }
+            if (metric.contains("priority") && !metric["priority"].is_number_integer()) {
+                error(path + ".priority", "must be an integer");
+            }
+        }
+    }
+
+    void outputs() {
+        if (!require_outputs_ && !config_.contains("outputs")) {
+            return;
+        }
+        if (!config_.contains("outputs") || !config_["outputs"].is_array() ||
+            (require_outputs_ && config_["outputs"].empty())) {
+            error("outputs", require_outputs_ ? "must be a non-empty array" : "must be an array");
+            return;
+        }
+
+        for (size_t i = 0; i < config_["outputs"].size(); ++i) {
+            const json &output = config_["outputs"][i];
+            std::string path = "outputs[" + std::to_string(i) + "]";
+            if (!output.is_object()) {
+                error(path, "must be an object");
+                continue;
+            }
+            if (!output.contains("type") || !output["type"].is_string()) {
+                error(path + ".type", "must be a string");
+                continue;
+            }
+
+            auto it = kOutputFields.find(output["type"].get<std::string>());
+            if (it == kOutputFields.end()) {
+                error(path + ".type", "unknown output type '" +
+                                          output["type"].get<std::string>() + "'");
+                continue;
+            }
+            // Достаточно одного из допустимых полей (file или path)
+            const auto &fields = it->second;
+            bool found = fields.empty();
+            for (const auto &field : fields) {
+                found = found || is_string(output, field.c_str());
+            }
+            if (!found) {
+                error(path + "." + fields.front(), "required for output '" + it->first + "'");
+            }
+            if (output.contains("deadband") && !output["deadband"].is_object()) {
+                error(path + ".deadband", "must be an object");
+            }
+        }
+    }
+
+    const json &config_;
+    bool require_outputs_;
+    std::vector<std::string> errors_;
+};
+
+} // namespace
+
+std::vector<std::string> validate_config(const json &config, bool require_outputs) {
+    return Validator(config, require_outputs).run();
+}
@@ -0,0 +1,37 @@
+#include "core/EventQueue.hpp"
+
+void EventQueue::push(const IMetric* metric, MetricValue value) {
+    Timestamp tick = Timestamp::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (events_.size() >= capacity_) {
+            events_.pop_front();
+            ++dropped_;
+        }
+        events_.push_back(Event{tick, metric, std::move(value)});
+    }
+    cv_.notify_one();
+}
+
+bool EventQueue::wait_until(std::chrono::steady_clock::time_point deadline,
+                            std::vector<Event> &out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cv_.wait_until(lock, deadline, [this] { return !events_.empty(); })) {
+        return false;
+    }
+
+    while (!events_.empty()) {
+        out.push_back(std::move(events_.front()));
+        events_.pop_front();
+    }
+    return true;
+}
+
+IMetric::EventCallback EventQueue::callback() {
+    return [this](const IMetric* metric, MetricValue value) { push(metric, std::move(value)); };
+}
+
+size_t EventQueue::dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
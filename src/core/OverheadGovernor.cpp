@@ -0,0 +1,126 @@
+#include "core/OverheadGovernor.hpp"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sched.h>
+#include <stdexcept>
+
+namespace {
+
+int64_t clock_ns(clockid_t clock) {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+} // namespace
+
+OverheadGovernor::OverheadGovernor(const json &config) : enabled_(true) {
+    if (!config.contains("budget") || !config["budget"].is_number() ||
+        config["budget"].get<double>() <= 0.0) {
+        throw std::invalid_argument("Governor requires positive 'budget' (percent of one core)");
+    }
+    budget_percent_ = config["budget"].get<double>();
+
+    if (config.contains("max_stretch")) {
+        if (!config["max_stretch"].is_number_integer() || config["max_stretch"].get<int>() < 1) {
+            throw std::invalid_argument("Governor 'max_stretch' must be a positive integer");
+        }
+        max_stretch_ = config["max_stretch"].get<int>();
+    }
+
+    if (config.contains("pin_cpu")) {
+        if (!config["pin_cpu"].is_number_integer() || config["pin_cpu"].get<int>() < 0 ||
+            config["pin_cpu"].get<int>() >= CPU_SETSIZE) {
+            throw std::invalid_argument("Governor 'pin_cpu' must be a valid CPU ID");
+        }
+        pin_cpu_ = config["pin_cpu"].get<int>();
+    }
+}
+
+int OverheadGovernor::max_level() const {
+    // Ступени растяжения периода (2, 4, ... до max_stretch) и пропуск метрик
+    int levels = 0;
+    for (int stretch = 1; stretch < max_stretch_; stretch *= 2) {
+        ++levels;
+    }
+    return levels + 1;
+}
+
+int OverheadGovernor::stretch() const {
+    int stretch = 1;
+    for (int i = 0; i < level_ && stretch < max_stretch_; ++i) {
+        stretch *= 2;
+    }
+    return stretch < max_stretch_ ? stretch : max_stretch_;
+}
+
+bool OverheadGovernor::skip(int priority) const {
+    return enabled_ && priority < 0 && level_ == max_level();
+}
+
+void OverheadGovernor::update() {
+    if (!enabled_) {
+        return;
+    }
+
+    int64_t cpu_ns = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+    int64_t wall_ns = clock_ns(CLOCK_MONOTONIC);
+    if (has_baseline_) {
+        update(cpu_ns - last_cpu_ns_, wall_ns - last_wall_ns_);
+    }
+    has_baseline_ = true;
+    last_cpu_ns_ = cpu_ns;
+    last_wall_ns_ = wall_ns;
+}
+
+void OverheadGovernor::update(int64_t cpu_ns, int64_t wall_ns) {
+    if (!enabled_ || wall_ns <= 0) {
+        return;
+    }
+
+    usage_percent_ = 100.0 * static_cast<double>(cpu_ns) / static_cast<double>(wall_ns);
+
+    if (usage_percent_ > budget_percent_) {
+        calm_ticks_ = 0;
+        if (level_ < max_level()) {
+            ++level_;
+        }
+        return;
+    }
+
+    // Откатываемся только после нескольких тиков с заметным запасом,
+    // чтобы не раскачивать период
+    if (usage_percent_ < budget_percent_ * kRestoreRatio && level_ > 0) {
+        if (++calm_ticks_ >= kCooldownTicks) {
+            --level_;
+            calm_ticks_ = 0;
+        }
+    } else {
+        calm_ticks_ = 0;
+    }
+}
+
+void OverheadGovernor::pin_current_thread() const {
+    if (pin_cpu_ < 0) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(pin_cpu_, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        throw std::runtime_error("Failed to pin collector to CPU " + std::to_string(pin_cpu_) +
+                                 ": " + std::strerror(errno));
+    }
+}
+
+MetricValue OverheadGovernor::collect() const {
+    return std::map<std::string, double>{
+        {"budget_percent", budget_percent_},
+        {"level", static_cast<double>(level_)},
+        {"skip_low_priority", level_ == max_level() ? 1.0 : 0.0},
+        {"stretch", static_cast<double>(stretch())},
+        {"usage_percent", usage_percent_},
+    };
+}
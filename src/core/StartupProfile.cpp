@@ -0,0 +1,97 @@
+#include "core/StartupProfile.hpp"
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+
+// Время от старта процесса до текущего момента по /proc/self/stat.
+// Точность ограничена тиком часов ядра (обычно 10 мс).
+int64_t process_age_ns() {
+    std::ifstream stat_file("/proc/self/stat");
+    std::string stat;
+    std::getline(stat_file, stat);
+
+    // Имя процесса в скобках может содержать пробелы - считаем поля после ')'
+    size_t pos = stat.rfind(')');
+    if (pos == std::string::npos) {
+        return -1;
+    }
+    std::istringstream fields(stat.substr(pos + 2));
+    std::string field;
+    // starttime - 22-е поле, после ')' идёт 3-е
+    for (int i = 3; i < 22 && fields >> field; ++i) {
+    }
+    unsigned long long start_ticks = 0;
+    if (!(fields >> start_ticks)) {
+        return -1;
+    }
+
+    timespec boot{};
+    clock_gettime(CLOCK_BOOTTIME, &boot);
+    int64_t now_ns = static_cast<int64_t>(boot.tv_sec) * 1000000000 + boot.tv_nsec;
+    int64_t start_ns = static_cast<int64_t>(start_ticks) * 1000000000 / sysconf(_SC_CLK_TCK);
+    return now_ns > start_ns ? now_ns - start_ns : 0;
+}
+
+double to_ms(int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+StartupProfile::StartupProfile(bool enabled) : enabled_(enabled) {
+    start_ = last_ = Clock::now();
+    if (enabled_) {
+        before_main_ns_ = process_age_ns();
+    }
+}
+
+void StartupProfile::mark(const std::string &phase) {
+    if (!enabled_) {
+        return;
+    }
+    auto now = Clock::now();
+    entries_.push_back(
+        {phase, std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count(), false});
+    for (auto &entry : nested_) {
+        entries_.push_back(std::move(entry));
+    }
+    nested_.clear();
+    last_ = now;
+}
+
+void StartupProfile::add(const std::string &name, Clock::duration duration) {
+    if (!enabled_) {
+        return;
+    }
+    nested_.push_back(
+        {name, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), true});
+}
+
+void StartupProfile::report(std::ostream &out) const {
+    if (!enabled_) {
+        return;
+    }
+
+    out << "Startup profile (ms):\n" << std::fixed << std::setprecision(2);
+    int64_t total = 0;
+    if (before_main_ns_ >= 0) {
+        out << "  " << std::left << std::setw(28) << "exec to main" << std::right
+            << std::setw(10) << to_ms(before_main_ns_) << "\n";
+        total += before_main_ns_;
+    }
+    for (const auto &entry : entries_) {
+        if (entry.nested) {
+            out << "    " << std::left << std::setw(26) << entry.name;
+        } else {
+            out << "  " << std::left << std::setw(28) << entry.name;
+            total += entry.ns;
+        }
+        out << std::right << std::setw(10) << to_ms(entry.ns) << "\n";
+    }
+    out << "  " << std::left << std::setw(28) << "total to first tick" << std::right
+        << std::setw(10) << to_ms(total) << std::endl;
+}
@@ -0,0 +1,53 @@
+#include "core/TimestampFormatter.hpp"
+#include <cstring>
+#include <ctime>
+
+void TimestampFormatter::update_prefix(int64_t second) {
+    time_t time = static_cast<time_t>(second);
+    tm local{};
+    localtime_r(&time, &local);
+
+    prefix_size_ = std::strftime(prefix_, sizeof(prefix_), "%Y-%m-%dT%H:%M:%S", &local);
+
+    // strftime выдаёт смещение как +0300, в ISO-8601 нужно +03:00
+    char zone[8] = {};
+    if (std::strftime(zone, sizeof(zone), "%z", &local) == 5) {
+        offset_[0] = zone[0];
+        offset_[1] = zone[1];
+        offset_[2] = zone[2];
+        offset_[3] = ':';
+        offset_[4] = zone[3];
+        offset_[5] = zone[4];
+        offset_size_ = 6;
+    } else {
+        offset_[0] = 'Z';
+        offset_size_ = 1;
+    }
+
+    cached_second_ = second;
+}
+
+std::string_view TimestampFormatter::format(int64_t realtime_ns) {
+    int64_t second = realtime_ns / 1000000000;
+    int64_t millis = (realtime_ns % 1000000000) / 1000000;
+    if (millis < 0) {
+        --second;
+        millis += 1000;
+    }
+
+    if (second != cached_second_) {
+        update_prefix(second);
+    }
+
+    char* out = buffer_;
+    std::memcpy(out, prefix_, prefix_size_);
+    out += prefix_size_;
+    *out++ = '.';
+    *out++ = static_cast<char>('0' + millis / 100);
+    *out++ = static_cast<char>('0' + millis / 10 % 10);
+    *out++ = static_cast<char>('0' + millis % 10);
+    std::memcpy(out, offset_, offset_size_);
+    out += offset_size_;
+
+    return std::string_view(buffer_, static_cast<size_t>(out - buffer_));
+}
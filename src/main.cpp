@@ -1,57 +1,119 @@
+#include "core/CommandLine.hpp"
+#include "core/ConfigValidator.hpp"
+#include "core/EventQueue.hpp"
+#include "core/OverheadGovernor.hpp"
+#include "core/StartupProfile.hpp"
 #include "metrics/MetricLoader.hpp"
+#include "net/Aggregator.hpp"
 #include "output/ConsoleOutput.hpp"
 #include "output/FileOutput.hpp"
+#include "output/JsonlOutput.hpp"
+#include "output/ShmOutput.hpp"
+#include "output/StdoutOutput.hpp"
+#include "output/StreamOutput.hpp"
 #include <chrono>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
-#include <thread>
 #include <vector>
 
 using json = nlohmann::json;
 
-std::vector<MetricLoader::MetricPtr> create_metrics(const json &config) {
-    std::vector<MetricLoader::MetricPtr> metrics;
+// Загружает метрики параллельно: dlopen и конструкторы метрик (открытие
+// файлов, обнаружение устройств, базовые замеры) выполняются одновременно.
+// Ошибки всех метрик собираются и выводятся вместе.
+std::vector<MetricLoader::MetricPtr> create_metrics(const json &config, std::ostream* log,
+                                                    StartupProfile &profile) {
+    struct Loaded {
+        MetricLoader::MetricPtr metric;
+        std::string error;
+        StartupProfile::Clock::duration elapsed{};
+    };
 
+    std::vector<std::future<Loaded>> pending;
     for (const auto &metric_config : config["metrics"]) {
-        try {
-            std::cout << "Loading metric: " << metric_config["type"] << std::endl;
+        pending.push_back(std::async(std::launch::async, [&metric_config]() {
+            Loaded loaded;
+            auto start = StartupProfile::Clock::now();
             std::string type = metric_config["type"];
-            std::string library_path = metric_config["library"].get<std::string>();
-            std::cout << "Library path: " << library_path << std::endl;
-            std::cout << "Config: " << metric_config["config"].dump() << std::endl;
-            
-            auto metric = MetricLoader::loadMetric(library_path, metric_config["config"]);
-            std::cout << "Metric loaded successfully" << std::endl;
-            
-            if (metric && metric->get() && metric->get()->is_valid()) {
-                std::cout << "Added metric: " << metric->get()->name() << std::endl;
-                metrics.push_back(std::move(metric));
-            } else {
-                throw std::runtime_error("Failed to create valid metric of type: " + type);
+            json metric_params = metric_config.value("config", json::object());
+            try {
+                // Без поля library используется встроенная метрика (статическая сборка)
+                if (metric_config.contains("library")) {
+                    loaded.metric = MetricLoader::loadMetric(
+                        metric_config["library"].get<std::string>(), metric_params);
+                } else {
+                    loaded.metric = MetricLoader::loadBuiltin(type, metric_params);
+                }
+                if (!loaded.metric || !loaded.metric->get() || !loaded.metric->get()->is_valid()) {
+                    loaded.metric.reset();
+                    throw std::runtime_error("Failed to create valid metric of type: " + type);
+                }
+            } catch (const std::exception &e) {
+                loaded.error = "metric '" + type + "': " + e.what();
             }
-        } catch (const std::exception &e) {
-            std::cerr << "Error creating metric: " << e.what() << std::endl;
-            throw;
+            loaded.elapsed = StartupProfile::Clock::now() - start;
+            return loaded;
+        }));
+    }
+
+    std::vector<MetricLoader::MetricPtr> metrics;
+    std::vector<std::string> errors;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        Loaded loaded = pending[i].get();
+        std::string type = config["metrics"][i]["type"];
+        profile.add("metric " + type, loaded.elapsed);
+        if (!loaded.error.empty()) {
+            errors.push_back(loaded.error);
+            continue;
         }
+        if (log) {
+            *log << "Loaded metric: " << type << " ("
+                 << config["metrics"][i].value("library", "built-in") << ")\n";
+        }
+        metrics.push_back(std::move(loaded.metric));
     }
 
+    if (!errors.empty()) {
+        for (const auto &error : errors) {
+            std::cerr << "Error creating " << error << "\n";
+        }
+        throw std::runtime_error(std::to_string(errors.size()) + " metric(s) failed to load");
+    }
     return metrics;
 }
 
-std::vector<std::shared_ptr<IOutput>> create_outputs(const json &config) {
+// С непустым format stdout занят машиночитаемым выводом: выходы console
+// пропускаются, вместо них добавляется StdoutOutput
+std::vector<std::shared_ptr<IOutput>> create_outputs(const json &config, const std::string &format,
+                                                     std::ostream* log) {
     std::vector<std::shared_ptr<IOutput>> outputs;
+    if (!format.empty()) {
+        outputs.push_back(std::make_shared<StdoutOutput>(json{{"format", format}}));
+        if (log) {
+            *log << "Added output: stdout (" << format << ")\n";
+        }
+    }
 
-    for (const auto &output_config : config["outputs"]) {
+    for (const auto &output_config : config.value("outputs", json::array())) {
+        if (!format.empty() && output_config["type"] == "console") {
+            continue;
+        }
         try {
-            std::cout << "Creating output: " << output_config["type"] << std::endl;
             std::shared_ptr<IOutput> output;
             if (output_config["type"] == "console") {
                 output = std::make_shared<ConsoleOutput>(output_config);
             } else if (output_config["type"] == "file") {
                 output = std::make_shared<FileOutput>(output_config);
+            } else if (output_config["type"] == "jsonl") {
+                output = std::make_shared<JsonlOutput>(output_config);
+            } else if (output_config["type"] == "stream") {
+                output = std::make_shared<StreamOutput>(output_config);
+            } else if (output_config["type"] == "shm") {
+                output = std::make_shared<ShmOutput>(output_config);
             } else {
                 throw std::invalid_argument("Unknown output type: " +
                                           output_config["type"].get<std::string>());
@@ -59,7 +121,9 @@ std::vector<std::shared_ptr<IOutput>> create_outputs(const json &config) {
 
             if (output && output->is_valid()) {
                 outputs.push_back(output);
-                std::cout << "Added output: " << output_config["type"] << std::endl;
+                if (log) {
+                    *log << "Added output: " << output_config["type"] << "\n";
+                }
             } else {
                 throw std::runtime_error("Failed to create valid output of type: " +
                                        output_config["type"].get<std::string>());
@@ -73,52 +137,116 @@ std::vector<std::shared_ptr<IOutput>> create_outputs(const json &config) {
     return outputs;
 }
 
+// Роль агрегатора: вместо локальных метрик выводим потоки агентов
+void run_aggregator(const json &config, const std::vector<std::shared_ptr<IOutput>> &outputs,
+                    int period, std::ostream &log) {
+    Aggregator aggregator(config["settings"]);
+    log << "\nAggregator listening on " << aggregator.endpoint().to_string()
+        << " with period " << period << " seconds..." << std::endl;
+    log << "Press Ctrl+C to stop\n" << std::endl;
+
+    auto next_tick = std::chrono::steady_clock::now() + std::chrono::seconds(period);
+    while (true) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             next_tick - std::chrono::steady_clock::now()).count();
+        if (remaining > 0) {
+            aggregator.poll(static_cast<int>(remaining));
+            continue;
+        }
+        next_tick += std::chrono::seconds(period);
+
+        Timestamp tick = Timestamp::now();
+        auto metric_values = aggregator.collect();
+        if (metric_values.empty()) {
+            continue;
+        }
+        for (const auto &output : outputs) {
+            if (output->is_valid()) {
+                output->write(tick, metric_values);
+            }
+        }
+    }
+}
+
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <config_file>" << std::endl;
+    CommandLine options;
+    try {
+        options = CommandLine::parse(argc, argv);
+    } catch (const std::invalid_argument &e) {
+        std::cerr << "Error: " << e.what() << "\n" << CommandLine::usage(argv[0]) << std::endl;
         return 1;
     }
+    StartupProfile profile(options.startup_profile);
 
     try {
-        std::cout << "Opening config file: " << argv[1] << std::endl;
-        std::ifstream config_file(argv[1]);
+        std::ifstream config_file(options.config_path);
         if (!config_file.is_open()) {
-            std::cerr << "Error: Cannot open config file: " << argv[1] << std::endl;
+            std::cerr << "Error: Cannot open config file: " << options.config_path << std::endl;
             return 1;
         }
 
         json config;
         try {
             config_file >> config;
-            std::cout << "Config loaded successfully" << std::endl;
         } catch (const json::exception &e) {
             std::cerr << "Error: Invalid JSON in config file: " << e.what() << std::endl;
             return 1;
         }
+        profile.mark("config read");
 
-        if (!config.contains("settings") || !config["settings"].contains("period")) {
-            std::cerr << "Error: Config file must contain 'settings.period'" << std::endl;
+        // Все ошибки конфигурации выводятся сразу
+        auto errors = validate_config(config, options.format.empty());
+        if (!errors.empty()) {
+            for (const auto &error : errors) {
+                std::cerr << "Error: " << error << "\n";
+            }
+            std::cerr << std::flush;
             return 1;
         }
+        profile.mark("config validation");
 
-        if (!config.contains("metrics") || !config["metrics"].is_array() ||
-            config["metrics"].empty()) {
-            std::cerr << "Error: Config file must contain non-empty 'metrics' array" << std::endl;
-            return 1;
+        // Журнал уходит в stderr, если stdout занят машиночитаемым выводом
+        std::ostream &log = options.format.empty() ? std::cout : std::clog;
+        bool verbose = options.verbose || config["settings"].value("verbose", false);
+        std::string role = config["settings"].value("role", "agent");
+        if (verbose) {
+            log << "Config loaded from " << options.config_path << "\n";
         }
 
-        if (!config.contains("outputs") || !config["outputs"].is_array() ||
-            config["outputs"].empty()) {
-            std::cerr << "Error: Config file must contain non-empty 'outputs' array" << std::endl;
+        if (role == "aggregator" && options.bounded()) {
+            std::cerr << "Error: --once, --count and --duration are not supported "
+                         "for the aggregator role" << std::endl;
             return 1;
         }
 
-        std::cout << "Creating metrics..." << std::endl;
-        auto metrics = create_metrics(config);
-        std::cout << "Creating outputs..." << std::endl;
-        auto outputs = create_outputs(config);
+        // Окно первого замера из командной строки дополняет конфигурацию
+        // встроенных метрик-скоростей, где оно не задано явно
+        if (role == "agent") {
+            options.apply_window(config);
+        }
+
+        // Поток сбора привязывается до загрузки метрик и создания выходов:
+        // их фоновые потоки наследуют привязку
+        OverheadGovernor governor;
+        if (role == "agent" && config["settings"].contains("governor")) {
+            governor = OverheadGovernor(config["settings"]["governor"]);
+            governor.pin_current_thread();
+        }
+
+        // Очередь объявлена до метрик, чтобы пережить их фоновые потоки
+        EventQueue events;
+        std::vector<MetricLoader::MetricPtr> metrics;
+        if (role == "agent") {
+            metrics = create_metrics(config, verbose ? &log : nullptr, profile);
+            for (const auto &metric : metrics) {
+                metric->get()->set_event_callback(events.callback());
+            }
+            profile.mark("metric loading");
+        }
+        auto outputs = create_outputs(config, options.format, verbose ? &log : nullptr);
+        profile.mark("output creation");
 
-        if (metrics.empty()) {
+        if (role == "agent" && metrics.empty()) {
             std::cerr << "Error: No valid metrics created" << std::endl;
             return 1;
         }
@@ -128,35 +256,103 @@ int main(int argc, char *argv[]) {
             return 1;
         }
 
-        // Получаем период из конфигурации
         int period = config["settings"]["period"].get<int>();
-        if (period <= 0) {
-            std::cerr << "Error: Period must be positive" << std::endl;
-            return 1;
+
+        if (role == "aggregator") {
+            run_aggregator(config, outputs, period, log);
+            return 0;
+        }
+
+        // Приоритеты метрик для ограничителя накладных расходов
+        std::vector<int> priorities;
+        for (const auto &metric_config : config["metrics"]) {
+            priorities.push_back(metric_config.value("priority", 0));
         }
 
-        std::cout << "\nStarting monitoring with period " << period << " seconds..." << std::endl;
-        std::cout << "Press Ctrl+C to stop\n" << std::endl;
+        // Накладные расходы первого тика считаются без загрузки метрик
+        governor.update();
 
+        if (verbose && !options.bounded()) {
+            log << "\nStarting monitoring with period " << period << " seconds...\n"
+                << "Press Ctrl+C to stop\n" << std::endl;
+        }
+
+        // Ограниченный запуск: не больше count тиков, и новый тик не
+        // начинается позже duration от первого
+        auto started = std::chrono::steady_clock::now();
+        auto deadline = started + std::chrono::milliseconds(options.duration_ms);
+        int64_t ticks = 0;
+        bool first_tick = true;
         while (true) {
+            // Время тика снимается один раз и передаётся всем выходам
+            Timestamp tick = Timestamp::now();
+
             // Вычисляем все метрики
             std::vector<std::pair<const IMetric*, MetricValue>> metric_values;
-            for (const auto &metric : metrics) {
+            for (size_t i = 0; i < metrics.size(); ++i) {
+                const auto &metric = metrics[i];
+                if (governor.skip(priorities[i])) {
+                    continue;
+                }
                 if (metric && metric->get() && metric->get()->is_valid()) {
                     auto* metric_ptr = metric->get();
-                    std::cout << "Collecting metric: " << metric_ptr->name() << std::endl;
+                    auto start = StartupProfile::Clock::now();
                     metric_values.emplace_back(metric_ptr, metric_ptr->collect());
+                    if (first_tick) {
+                        profile.add("collect " + metric_ptr->name(),
+                                    StartupProfile::Clock::now() - start);
+                    }
                 }
             }
+            if (first_tick) {
+                profile.mark("first collect");
+            }
+
+            if (governor.enabled()) {
+                metric_values.emplace_back(&governor, governor.collect());
+            }
 
             // Передаем результаты во все выходы
             for (const auto &output : outputs) {
                 if (output->is_valid()) {
-                    output->write(metric_values);
+                    output->write(tick, metric_values);
+                }
+            }
+
+            if (first_tick) {
+                profile.mark("first write");
+                profile.report(std::cerr);
+                first_tick = false;
+            }
+
+            ++ticks;
+            if (options.count > 0 && ticks >= options.count) {
+                break;
+            }
+
+            governor.update();
+
+            // Ждём следующего тика, сразу выводя внеочередные значения метрик
+            auto next_tick = std::chrono::steady_clock::now() +
+                             std::chrono::seconds(period * governor.stretch());
+            if (options.duration_ms > 0 && next_tick >= deadline) {
+                break;
+            }
+            std::vector<EventQueue::Event> pending;
+            while (events.wait_until(next_tick, pending)) {
+                for (const auto &event : pending) {
+                    for (const auto &output : outputs) {
+                        if (output->is_valid()) {
+                            output->write_event(event.tick, event.metric, event.value);
+                        }
+                    }
                 }
+                pending.clear();
             }
+        }
 
-            std::this_thread::sleep_for(std::chrono::seconds(period));
+        for (const auto &output : outputs) {
+            output->finish();
         }
     } catch (const std::exception &e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
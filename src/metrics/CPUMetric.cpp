@@ -1,13 +1,28 @@
 #include "metrics/CPUMetric.hpp"
+#include "core/Timestamp.hpp"
+#include "metrics/MetricRegistry.hpp"
+#include "metrics/ProcFile.hpp"
 #include <algorithm>
 #include <chrono>
-#include <fstream>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
 #include <stdexcept>
 #include <thread>
 #include <set>
+#include <string_view>
+#include <unistd.h>
 
-CPUMetric::CPUMetric(const json &config) : first_measurement_(true) {
+namespace {
+
+// Окно, по которому по умолчанию считается загрузка в первом периоде.
+// Короткое, чтобы первый тик не ждал секунду после загрузки; следующие
+// периоды длиннее окна и его не ждут.
+constexpr int kDefaultWindowMs = 100;
+
+} // namespace
+
+CPUMetric::CPUMetric(const json &config) {
     if (!config.contains("cpu_ids") || !config["cpu_ids"].is_array()) {
         throw std::invalid_argument("CPU metric requires 'cpu_ids' array");
     }
@@ -30,81 +45,198 @@ CPUMetric::CPUMetric(const json &config) : first_measurement_(true) {
     if (cpu_ids_.empty()) {
         throw std::invalid_argument("CPU metric requires at least one CPU ID");
     }
-}
-
-MetricValue CPUMetric::collect() const {
-    std::vector<double> usage(cpu_ids_.size(), 0.0);  // Инициализируем вектор нулями
-    std::map<int, CPUStats> current_stats;
 
-    // Collect current values
-    std::ifstream stat_file("/proc/stat");
+    if (config.contains("subsample_ms")) {
+        if (!config["subsample_ms"].is_number_integer() || config["subsample_ms"].get<int>() <= 0) {
+            throw std::invalid_argument("CPU 'subsample_ms' must be a positive integer");
+        }
+        subsample_ms_ = config["subsample_ms"].get<int>();
+    }
 
-    if (!stat_file.is_open()) {
-        throw std::runtime_error("Failed to open /proc/stat");
+    int window_ms = kDefaultWindowMs;
+    if (config.contains("window_ms")) {
+        if (!config["window_ms"].is_number_integer() || config["window_ms"].get<int>() <= 0) {
+            throw std::invalid_argument("CPU 'window_ms' must be a positive integer");
+        }
+        window_ms = config["window_ms"].get<int>();
     }
+    window_ns_ = static_cast<int64_t>(window_ms) * 1000000;
 
-    std::string line;
+    stat_fd_ = open("/proc/stat", O_RDONLY | O_CLOEXEC);
 
-    // Пропускаем строку с общей статистикой
-    std::getline(stat_file, line);
+    // Строки cpuN идут в начале /proc/stat, буфер рассчитан на них
+    long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    collect_buffer_.resize(static_cast<size_t>(std::max(cpus, 1L) + 1) * 192 + 4096);
 
-    while (std::getline(stat_file, line)) {
-        std::istringstream iss(line);
-        std::string cpu_label;
-        iss >> cpu_label;
+    // Номера ядер за пределами настроенных в системе в /proc/stat не встречаются
+    int max_id = std::min(*std::max_element(cpu_ids_.begin(), cpu_ids_.end()),
+                          static_cast<int>(std::max(cpus, 1L)) - 1);
+    cpu_index_.assign(static_cast<size_t>(std::max(max_id, 0)) + 1, kNoIndex);
+    for (size_t i = 0; i < cpu_ids_.size(); ++i) {
+        if (static_cast<size_t>(cpu_ids_[i]) < cpu_index_.size()) {
+            cpu_index_[cpu_ids_[i]] = i;
+        }
+    }
 
-        // Пропускаем строки, которые не относятся к CPU
-        if (cpu_label.substr(0, 3) != "cpu")
-            continue;
+    if (subsample_ms_ > 0) {
+        accumulators_.resize(cpu_ids_.size());
+        snapshot_.resize(cpu_ids_.size());
+        sampler_ = std::thread(&CPUMetric::sample_loop, this);
+    } else if (stat_fd_ >= 0) {
+        // Базовый замер при загрузке: окно первого периода отсчитывается
+        // отсюда, и первый collect() ждёт только оставшуюся часть окна
+        std::vector<double> usage(cpu_ids_.size(), 0.0);
+        std::vector<char> present(cpu_ids_.size(), 0);
+        read_usage(rates_, collect_buffer_, usage, present);
+    }
+}
 
-        // Извлекаем номер CPU из метки (например, "cpu0" -> 0)
-        int cpu_id = std::stoi(cpu_label.substr(3));
+CPUMetric::~CPUMetric() {
+    if (sampler_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        stop_cv_.notify_all();
+        sampler_.join();
+    }
+    if (stat_fd_ >= 0) {
+        close(stat_fd_);
+    }
+}
 
-        // Проверяем, нужно ли собирать статистику для этого CPU
-        if (std::find(cpu_ids_.begin(), cpu_ids_.end(), cpu_id) != cpu_ids_.end()) {
-            CPUStats stats;
-            iss >> stats.user >> stats.nice >> stats.system >> stats.idle >>
-                stats.iowait >> stats.irq >> stats.softirq >> stats.steal >>
-                stats.guest;
+bool CPUMetric::read_usage(CounterRates &rates, std::vector<char> &buffer,
+                           std::vector<double> &usage, std::vector<char> &present) const {
+    ssize_t size = procfile::read_all(stat_fd_, buffer);
+    if (size <= 0) {
+        return false;
+    }
 
-            current_stats[cpu_id] = stats;
+    std::fill(present.begin(), present.end(), 0);
+    const char *p = buffer.data();
+    const char *end = p + size;
+    uint64_t counters[kCounters];
+
+    rates.begin(Timestamp::now().monotonic_ns);
+    while (p < end) {
+        const char *line_end = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!line_end) {
+            line_end = end;
+        }
+        if (line_end - p < 4 || std::strncmp(p, "cpu", 3) != 0) {
+            break;  // Строки cpu закончились
         }
+
+        const char *label = p;
+        p += 3;
+        if (*p != ' ') {
+            uint64_t cpu_id = procfile::parse_u64(p, line_end);
+            std::string_view key(label, p - label);
+            size_t index = cpu_id < cpu_index_.size() ? cpu_index_[cpu_id] : kNoIndex;
+            if (index != kNoIndex) {
+                for (auto &counter : counters) {
+                    counter = procfile::parse_u64(p, line_end);
+                }
+                const uint64_t *d = rates.update(key, counters);
+                unsigned long long idle = d ? d[Idle] + d[Iowait] : 0;
+                unsigned long long total = d ? idle + d[User] + d[Nice] + d[System] +
+                                                   d[Irq] + d[Softirq] + d[Steal]
+                                             : 0;
+                // Ядро без приращений (первый замер, нет изменений) пропускаем
+                if (total > 0) {
+                    usage[index] = 100.0 * (total - idle) / total;
+                    present[index] = 1;
+                }
+            }
+        }
+        p = line_end + 1;
     }
+    rates.end();
+    return true;
+}
 
-    if (first_measurement_) {
-        prev_stats_ = current_stats;
-        first_measurement_ = false;
+void CPUMetric::sample_loop() {
+    // Все буферы выделяются один раз до начала замеров
+    CounterRates rates(kCounters);
+    std::vector<char> buffer(collect_buffer_.size());
+    std::vector<double> usage(cpu_ids_.size(), 0.0);
+    std::vector<char> present(cpu_ids_.size(), 0);
+    const auto interval = std::chrono::milliseconds(subsample_ms_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        lock.unlock();
+        bool ok = stat_fd_ >= 0 && read_usage(rates, buffer, usage, present);
+        lock.lock();
+
+        if (ok) {
+            for (size_t i = 0; i < cpu_ids_.size(); ++i) {
+                if (present[i]) {
+                    accumulators_[i].add(usage[i]);
+                }
+            }
+            if (!sampled_ && rates.interval() > 0.0) {
+                sampled_ = true;
+                sample_cv_.notify_all();
+            }
+        }
 
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        stop_cv_.wait_for(lock, interval, [this] { return stop_; });
+    }
+}
 
-        return collect();
+MetricValue CPUMetric::collect_subsampled() const {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Первое приращение появляется только после второго чтения /proc/stat:
+        // первый период ждёт его, а не отдаёт пустой отчёт
+        if (!sampled_) {
+            sample_cv_.wait_for(lock, std::chrono::milliseconds(subsample_ms_) * 4,
+                                [this] { return sampled_; });
+        }
+        accumulators_.swap(snapshot_);
+        for (auto &accumulator : accumulators_) {
+            accumulator.reset();
+        }
     }
 
-    // Вычисляем загруженность для каждого CPU
+    std::map<std::string, double> stats;
     for (size_t i = 0; i < cpu_ids_.size(); ++i) {
-        int cpu_id = cpu_ids_[i];
-        if (current_stats.find(cpu_id) == current_stats.end() ||
-            prev_stats_.find(cpu_id) == prev_stats_.end()) {
-            continue;  // Оставляем 0.0 для несуществующего CPU
+        const UsageAccumulator &accumulator = snapshot_[i];
+        if (accumulator.count() == 0) {
+            continue;  // Ещё нет замеров или CPU не существует
         }
+        std::string prefix = "cpu" + std::to_string(cpu_ids_[i]);
+        stats[prefix + ".max"] = accumulator.max();
+        stats[prefix + ".mean"] = accumulator.mean();
+        stats[prefix + ".min"] = accumulator.min();
+        stats[prefix + ".p95"] = accumulator.percentile(0.95);
+    }
+    return stats;
+}
 
-        const CPUStats &current = current_stats[cpu_id];
-        const CPUStats &prev = prev_stats_[cpu_id];
+MetricValue CPUMetric::collect() const {
+    if (subsample_ms_ > 0) {
+        return collect_subsampled();
+    }
 
-        unsigned long long idle_diff = current.idle_time() - prev.idle_time();
-        unsigned long long total_diff = current.total_time() - prev.total_time();
+    if (stat_fd_ < 0) {
+        throw std::runtime_error("Failed to open /proc/stat");
+    }
 
-        if (total_diff == 0) {
-            continue;  // Оставляем 0.0 для CPU без изменений
-        }
+    rates_.wait_interval(window_ns_, Timestamp::now().monotonic_ns);
 
-        // Использование CPU в процентах
-        double cpu_usage = 100.0 * (total_diff - idle_diff) / total_diff;
-        usage[i] = cpu_usage;
+    std::vector<double> usage(cpu_ids_.size(), 0.0);  // Инициализируем вектор нулями
+    std::vector<char> present(cpu_ids_.size(), 0);
+    if (!read_usage(rates_, collect_buffer_, usage, present)) {
+        throw std::runtime_error("Failed to read /proc/stat");
     }
 
-    // Сохраняем текущие значения для следующего измерения
-    prev_stats_ = current_stats;
+    // Базы ещё нет: первый замер служит базой для приращений
+    if (rates_.interval() == 0.0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(window_ns_));
+        return collect();
+    }
 
     return usage;
 }
@@ -117,12 +249,4 @@ std::string CPUMetric::name() const {
     return "cpu";
 }
 
-extern "C" {
-    IMetric* createMetric(const json& config) {
-        return new CPUMetric(config);
-    }
-    
-    void destroyMetric(IMetric* metric) {
-        delete metric;
-    }
-}
+STATUS_MONITOR_METRIC("cpu", CPUMetric)
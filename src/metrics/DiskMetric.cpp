@@ -0,0 +1,119 @@
+#include "metrics/DiskMetric.hpp"
+#include "metrics/MetricRegistry.hpp"
+#include "metrics/ProcFile.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Первые 11 полей статистики устройства есть во всех версиях ядра
+constexpr size_t kFields = 11;
+constexpr size_t kReads = 0;
+constexpr size_t kSectorsRead = 2;
+constexpr size_t kReadMs = 3;
+constexpr size_t kWrites = 4;
+constexpr size_t kSectorsWritten = 6;
+constexpr size_t kWriteMs = 7;
+constexpr size_t kIoMs = 9;
+
+// Счётчики, передаваемые в CounterRates
+enum Counter { Reads, SectorsRead, ReadMs, Writes, SectorsWritten, WriteMs, IoMs, kCounters };
+
+// Размер сектора в /proc/diskstats не зависит от устройства
+constexpr double kSectorSize = 512.0;
+
+} // namespace
+
+DiskMetric::DiskMetric(const json &config)
+    : file_(config, "Disk", "diskstats", "Disk statistics", kCounters) {
+    if (file_.needs_baseline()) {
+        collect();
+    }
+}
+
+MetricValue DiskMetric::collect() const {
+    std::map<std::string, double> stats;
+    std::string_view data = file_.read();
+    if (data.empty()) {
+        return stats;
+    }
+
+    CounterRates &devices = file_.rates();
+    const char* p = data.data();
+    const char* end = p + data.size();
+    uint64_t fields[kFields];
+    uint64_t counters[kCounters];
+    std::string key;
+
+    double interval = devices.interval();
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!line_end) {
+            line_end = end;
+        }
+
+        // "major minor имя поля..."
+        procfile::parse_u64(p, line_end);
+        procfile::parse_u64(p, line_end);
+        const char* name = procfile::skip_spaces(p, line_end);
+        p = procfile::skip_word(name, line_end);
+        std::string_view device(name, p - name);
+
+        if (!device.empty()) {
+            for (auto &field : fields) {
+                field = procfile::parse_u64(p, line_end);
+            }
+            counters[Reads] = fields[kReads];
+            counters[SectorsRead] = fields[kSectorsRead];
+            counters[ReadMs] = fields[kReadMs];
+            counters[Writes] = fields[kWrites];
+            counters[SectorsWritten] = fields[kSectorsWritten];
+            counters[WriteMs] = fields[kWriteMs];
+            counters[IoMs] = fields[kIoMs];
+
+            const uint64_t* d = devices.update(device, counters);
+            if (d && interval > 0.0) {
+                uint64_t ios = d[Reads] + d[Writes];
+                auto put = [&](const char* suffix, double value) {
+                    key.assign(device.data(), device.size());
+                    key += suffix;
+                    stats[key] = value;
+                };
+                put(".read_iops", d[Reads] / interval);
+                put(".write_iops", d[Writes] / interval);
+                put(".read_bytes", d[SectorsRead] * kSectorSize / interval);
+                put(".write_bytes", d[SectorsWritten] * kSectorSize / interval);
+                put(".await_ms", ios ? static_cast<double>(d[ReadMs] + d[WriteMs]) / ios : 0.0);
+                put(".util", std::min(100.0, d[IoMs] / (interval * 10.0)));
+            }
+        }
+        p = line_end + 1;
+    }
+    devices.end();
+
+    return stats;
+}
+
+bool DiskMetric::is_valid() const {
+    return file_.is_open();
+}
+
+const char* DiskMetric::unit(std::string_view key) const {
+    std::string_view field = key.substr(key.rfind('.') + 1);
+    if (field == "read_bytes" || field == "write_bytes") {
+        return "B/s";
+    }
+    if (field == "read_iops" || field == "write_iops") {
+        return "IOPS";
+    }
+    if (field == "await_ms") {
+        return "ms";
+    }
+    return field == "util" ? "%" : "";
+}
+
+std::string DiskMetric::name() const {
+    return "disk";
+}
+
+STATUS_MONITOR_METRIC("disk", DiskMetric)
@@ -1,11 +1,16 @@
 #include "metrics/MemoryMetric.hpp"
+#include "metrics/MetricRegistry.hpp"
+#include "metrics/ProcFile.hpp"
 #include <algorithm>
-#include <fstream>
-#include <sstream>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
 #include <stdexcept>
 #include <set>
+#include <unistd.h>
 
-MemoryMetric::MemoryMetric(const json &config) {
+MemoryMetric::MemoryMetric(const json &config) : buffer_(8192) {
     if (config.contains("spec") && config["spec"].is_array()) {
         std::set<std::string> unique_specs;
         bool has_duplicates = false;
@@ -29,31 +34,112 @@ MemoryMetric::MemoryMetric(const json &config) {
             }
         }
     }
-}
 
-MetricValue MemoryMetric::collect() const {
-    std::map<std::string, double> memory_info;
-    std::ifstream meminfo_file("/proc/meminfo");
-    std::string line;
+    std::string proc_root = "/proc";
+    if (config.contains("proc_root")) {
+        if (!config["proc_root"].is_string()) {
+            throw std::invalid_argument("Memory 'proc_root' must be a string");
+        }
+        proc_root = config["proc_root"].get<std::string>();
+    }
+    std::string path = proc_root + "/meminfo";
+    fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "Memory statistics are unavailable: " << path << std::endl;
+    }
 
-    while (std::getline(meminfo_file, line)) {
-        std::istringstream iss(line);
-        std::string key;
-        double value;
-        std::string unit;
+    if (config.contains("numa")) {
+        if (!config["numa"].is_boolean()) {
+            throw std::invalid_argument("Memory 'numa' must be a boolean");
+        }
+        if (config["numa"].get<bool>() && !specs_.empty()) {
+            std::string sysfs_root = "/sys";
+            if (config.contains("sysfs_root")) {
+                if (!config["sysfs_root"].is_string()) {
+                    throw std::invalid_argument("Memory 'sysfs_root' must be a string");
+                }
+                sysfs_root = config["sysfs_root"].get<std::string>();
+            }
 
-        iss >> key >> value >> unit;
+            std::vector<std::string> stat_fields;
+            if (config.contains("numastat")) {
+                if (!config["numastat"].is_array()) {
+                    throw std::invalid_argument("Memory 'numastat' must be an array");
+                }
+                std::set<std::string> unique_fields;
+                for (const auto &field : config["numastat"]) {
+                    if (!field.is_string() || field.get<std::string>().empty()) {
+                        throw std::invalid_argument("Memory 'numastat' fields must be non-empty strings");
+                    }
+                    if (!unique_fields.insert(field.get<std::string>()).second) {
+                        throw std::invalid_argument("Duplicate 'numastat' fields are not allowed");
+                    }
+                }
+                stat_fields.assign(unique_fields.begin(), unique_fields.end());
+            }
 
-        // Убираем двоеточие из ключа
-        key = key.substr(0, key.length() - 1);
+            size_t threads = 0;
+            if (config.contains("numa_threads")) {
+                if (!config["numa_threads"].is_number_integer() ||
+                    config["numa_threads"].get<int>() <= 0) {
+                    throw std::invalid_argument("Memory 'numa_threads' must be a positive integer");
+                }
+                threads = config["numa_threads"].get<size_t>();
+            }
 
-        // Конвертируем в МБ
-        if (unit == "kB") {
-            value /= 1024.0;
+            numa_ = std::make_unique<NumaMemory>(sysfs_root, specs_, stat_fields, threads);
         }
+    }
+}
+
+MemoryMetric::~MemoryMetric() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
 
-        if (std::find(specs_.begin(), specs_.end(), key) != specs_.end()) {
-            memory_info[key] = value;
+MetricValue MemoryMetric::collect() const {
+    std::map<std::string, double> memory_info;
+
+    // Строки вида "MemFree:   3604584 kB"; файл перечитывается через pread
+    ssize_t size = fd_ >= 0 ? procfile::read_all(fd_, buffer_) : -1;
+    const char* p = buffer_.data();
+    const char* end = p + std::max<ssize_t>(size, 0);
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!line_end) {
+            line_end = end;
+        }
+        const char* colon = static_cast<const char*>(std::memchr(p, ':', line_end - p));
+        if (colon) {
+            std::string_view key(p, colon - p);
+            for (const auto &spec : specs_) {
+                if (spec == key) {
+                    p = colon + 1;
+                    double value = static_cast<double>(procfile::parse_u64(p, line_end));
+                    p = procfile::skip_spaces(p, line_end);
+                    // Конвертируем в МБ
+                    bool kb = line_end - p >= 2 && p[0] == 'k' && p[1] == 'B';
+                    memory_info[spec] = kb ? value / 1024.0 : value;
+                    break;
+                }
+            }
+        }
+        p = line_end + 1;
+    }
+
+    if (numa_) {
+        numa_->refresh();
+        const auto &nodes = numa_->nodes();
+        const auto &fields = numa_->fields();
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            std::string prefix = "node" + std::to_string(nodes[node]) + ".";
+            for (size_t field = 0; field < fields.size(); ++field) {
+                double value = numa_->value(node, field);
+                if (!std::isnan(value)) {
+                    memory_info[prefix + fields[field]] = value;
+                }
+            }
         }
     }
 
@@ -61,19 +147,17 @@ MetricValue MemoryMetric::collect() const {
 }
 
 bool MemoryMetric::is_valid() const {
-    return !specs_.empty();
+    return !specs_.empty() && fd_ >= 0;
+}
+
+// Все поля, включая узлы NUMA и numastat, выводятся в МБ
+const char* MemoryMetric::unit(std::string_view key) const {
+    (void)key;
+    return "MB";
 }
 
 std::string MemoryMetric::name() const {
     return "memory";
 }
 
-extern "C" {
-    IMetric* createMetric(const json& config) {
-        return new MemoryMetric(config);
-    }
-    
-    void destroyMetric(IMetric* metric) {
-        delete metric;
-    }
-}
+STATUS_MONITOR_METRIC("memory", MemoryMetric)
@@ -0,0 +1,95 @@
+#include "metrics/NetMetric.hpp"
+#include "metrics/MetricRegistry.hpp"
+#include "metrics/ProcFile.hpp"
+#include <cstring>
+
+namespace {
+
+// Поля строки интерфейса в /proc/net/dev
+constexpr size_t kFields = 16;
+constexpr size_t kRxBytes = 0;
+constexpr size_t kRxPackets = 1;
+constexpr size_t kTxBytes = 8;
+constexpr size_t kTxPackets = 9;
+
+// Счётчики, передаваемые в CounterRates, и имена их скоростей
+constexpr size_t kCounters = 4;
+const char* const kNames[kCounters] = {".rx_bytes", ".rx_packets", ".tx_bytes", ".tx_packets"};
+
+} // namespace
+
+NetMetric::NetMetric(const json &config)
+    : file_(config, "Net", "net/dev", "Network statistics", kCounters) {
+    if (file_.needs_baseline()) {
+        collect();
+    }
+}
+
+MetricValue NetMetric::collect() const {
+    std::map<std::string, double> rates;
+    std::string_view data = file_.read();
+    if (data.empty()) {
+        return rates;
+    }
+
+    CounterRates &devices = file_.rates();
+    const char* p = data.data();
+    const char* end = p + data.size();
+    uint64_t fields[kFields];
+    uint64_t counters[kCounters];
+    std::string key;
+
+    double interval = devices.interval();
+    int line = 0;
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!line_end) {
+            line_end = end;
+        }
+        // Первые две строки - заголовок таблицы
+        const char* colon = line++ < 2 ? nullptr
+                                       : static_cast<const char*>(std::memchr(p, ':', line_end - p));
+        if (colon) {
+            const char* name = procfile::skip_spaces(p, colon);
+            p = colon + 1;
+            for (auto &field : fields) {
+                field = procfile::parse_u64(p, line_end);
+            }
+            counters[0] = fields[kRxBytes];
+            counters[1] = fields[kRxPackets];
+            counters[2] = fields[kTxBytes];
+            counters[3] = fields[kTxPackets];
+
+            const uint64_t* delta = devices.update(std::string_view(name, colon - name), counters);
+            if (delta && interval > 0.0) {
+                for (size_t i = 0; i < kCounters; ++i) {
+                    key.assign(name, colon - name);
+                    key += kNames[i];
+                    rates[key] = delta[i] / interval;
+                }
+            }
+        }
+        p = line_end + 1;
+    }
+    devices.end();
+
+    return rates;
+}
+
+bool NetMetric::is_valid() const {
+    return file_.is_open();
+}
+
+const char* NetMetric::unit(std::string_view key) const {
+    std::string_view field = key.substr(key.rfind('.') + 1);
+    if (field == "rx_bytes" || field == "tx_bytes") {
+        return "B/s";
+    }
+    return "pkt/s";
+}
+
+std::string NetMetric::name() const {
+    return "net";
+}
+
+STATUS_MONITOR_METRIC("net", NetMetric)
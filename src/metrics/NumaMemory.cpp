@@ -0,0 +1,187 @@
+#include "metrics/NumaMemory.hpp"
+#include "metrics/ProcFile.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t kMaxDefaultThreads = 8;
+constexpr size_t kInitialBuffer = 8192;
+
+size_t find_field(const std::vector<std::string> &fields, size_t begin, size_t end,
+                  const char *key, size_t length) {
+    for (size_t i = begin; i < end; ++i) {
+        if (fields[i].size() == length && std::memcmp(fields[i].data(), key, length) == 0) {
+            return i;
+        }
+    }
+    return end;
+}
+
+} // namespace
+
+NumaMemory::NumaMemory(const std::string &sysfs_root, std::vector<std::string> fields,
+                       std::vector<std::string> stat_fields, size_t threads) {
+    fields_ = std::move(fields);
+    meminfo_fields_ = fields_.size();
+    fields_.insert(fields_.end(), stat_fields.begin(), stat_fields.end());
+    page_mb_ = static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+
+    std::string node_dir = sysfs_root + "/devices/system/node";
+    if (DIR *dir = opendir(node_dir.c_str())) {
+        while (dirent *entry = readdir(dir)) {
+            const char *name = entry->d_name;
+            if (std::strncmp(name, "node", 4) != 0 || name[4] == '\0' ||
+                !std::all_of(name + 4, name + std::strlen(name),
+                             [](char c) { return c >= '0' && c <= '9'; })) {
+                continue;
+            }
+            node_ids_.push_back(std::atoi(name + 4));
+        }
+        closedir(dir);
+    }
+    std::sort(node_ids_.begin(), node_ids_.end());
+
+    nodes_.resize(node_ids_.size());
+    for (size_t i = 0; i < node_ids_.size(); ++i) {
+        std::string path = node_dir + "/node" + std::to_string(node_ids_[i]);
+        if (meminfo_fields_ > 0) {
+            nodes_[i].meminfo_fd = open((path + "/meminfo").c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        if (fields_.size() > meminfo_fields_) {
+            nodes_[i].numastat_fd = open((path + "/numastat").c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        nodes_[i].buffer.resize(kInitialBuffer);
+    }
+    values_.assign(nodes_.size() * fields_.size(), std::numeric_limits<double>::quiet_NaN());
+
+    if (threads == 0) {
+        threads = std::min(nodes_.size(), kMaxDefaultThreads);
+    }
+    threads = std::max<size_t>(1, std::min(threads, nodes_.size()));
+    // Одну часть узлов читает сам вызывающий поток
+    for (size_t share = 1; share < threads; ++share) {
+        workers_.emplace_back(&NumaMemory::worker_loop, this, share);
+    }
+}
+
+NumaMemory::~NumaMemory() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+    for (auto &node : nodes_) {
+        if (node.meminfo_fd >= 0) {
+            close(node.meminfo_fd);
+        }
+        if (node.numastat_fd >= 0) {
+            close(node.numastat_fd);
+        }
+    }
+}
+
+void NumaMemory::read_node(size_t index) {
+    Node &node = nodes_[index];
+    double *row = values_.data() + index * fields_.size();
+    std::fill(row, row + fields_.size(), std::numeric_limits<double>::quiet_NaN());
+
+    // Строки вида "Node 0 MemFree:   3604584 kB"
+    if (node.meminfo_fd >= 0) {
+        ssize_t size = procfile::read_all(node.meminfo_fd, node.buffer);
+        const char *p = node.buffer.data();
+        const char *end = p + std::max<ssize_t>(size, 0);
+        while (p < end) {
+            const char *line_end = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!line_end) {
+                line_end = end;
+            }
+            p = procfile::skip_word(procfile::skip_spaces(p, line_end), line_end);  // "Node"
+            p = procfile::skip_word(procfile::skip_spaces(p, line_end), line_end);  // номер узла
+            const char *key = procfile::skip_spaces(p, line_end);
+            const char *colon = static_cast<const char *>(std::memchr(key, ':', line_end - key));
+            if (colon) {
+                size_t field = find_field(fields_, 0, meminfo_fields_, key, colon - key);
+                if (field < meminfo_fields_) {
+                    p = colon + 1;
+                    double value = static_cast<double>(procfile::parse_u64(p, line_end));
+                    p = procfile::skip_spaces(p, line_end);
+                    bool kb = line_end - p >= 2 && p[0] == 'k' && p[1] == 'B';
+                    row[field] = kb ? value / 1024.0 : value;
+                }
+            }
+            p = line_end + 1;
+        }
+    }
+
+    // Строки вида "numa_hit 18225702", значения в страницах
+    if (node.numastat_fd >= 0) {
+        ssize_t size = procfile::read_all(node.numastat_fd, node.buffer);
+        const char *p = node.buffer.data();
+        const char *end = p + std::max<ssize_t>(size, 0);
+        while (p < end) {
+            const char *line_end = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!line_end) {
+                line_end = end;
+            }
+            const char *key = procfile::skip_spaces(p, line_end);
+            p = procfile::skip_word(key, line_end);
+            size_t field = find_field(fields_, meminfo_fields_, fields_.size(), key, p - key);
+            if (field < fields_.size()) {
+                row[field] = static_cast<double>(procfile::parse_u64(p, line_end)) * page_mb_;
+            }
+            p = line_end + 1;
+        }
+    }
+}
+
+void NumaMemory::read_share(size_t share) {
+    for (size_t i = share; i < nodes_.size(); i += threads()) {
+        read_node(i);
+    }
+}
+
+void NumaMemory::worker_loop(size_t share) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        start_cv_.wait(lock, [&] { return stop_ || round_ != seen; });
+        if (stop_) {
+            return;
+        }
+        seen = round_;
+        lock.unlock();
+        read_share(share);
+        lock.lock();
+        if (--pending_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void NumaMemory::refresh() {
+    if (workers_.empty()) {
+        read_share(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++round_;
+        pending_ = workers_.size();
+    }
+    start_cv_.notify_all();
+
+    read_share(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+}
@@ -0,0 +1,279 @@
+#include "metrics/PSIMetric.hpp"
+#include "metrics/MetricRegistry.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <set>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+
+const std::set<std::string> kResources = {"cpu", "io", "memory"};
+
+// Ограничения окна триггера в ядре
+constexpr uint64_t kMinWindowUs = 500000;
+constexpr uint64_t kMaxWindowUs = 10000000;
+
+// Регистрирует триггер ядра: запись спецификации в файл ресурса.
+// Триггер живёт, пока открыт дескриптор.
+int open_kernel_trigger(const std::string &path, const std::string &resource,
+                        const std::string &spec) {
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "PSI trigger for " << resource << " unavailable ("
+                  << std::strerror(errno) << "), falling back to polling" << std::endl;
+        return -1;
+    }
+    if (::write(fd, spec.c_str(), spec.size() + 1) < 0) {
+        std::cerr << "PSI trigger for " << resource << " rejected ("
+                  << std::strerror(errno) << "), falling back to polling" << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+PSIMetric::PSIMetric(const json &config) : PSIMetric(config, nullptr) {}
+
+PSIMetric::PSIMetric(const json &config, TriggerOpener open_trigger)
+    : open_trigger_(std::move(open_trigger)) {
+    if (config.contains("proc_root")) {
+        if (!config["proc_root"].is_string()) {
+            throw std::invalid_argument("PSI 'proc_root' must be a string");
+        }
+        proc_root_ = config["proc_root"].get<std::string>();
+    }
+
+    std::vector<std::string> names = {"cpu", "memory", "io"};
+    if (config.contains("resources")) {
+        if (!config["resources"].is_array()) {
+            throw std::invalid_argument("PSI 'resources' must be an array");
+        }
+        names.clear();
+        std::set<std::string> unique;
+        for (const auto &resource : config["resources"]) {
+            if (!resource.is_string() || !kResources.count(resource.get<std::string>())) {
+                throw std::invalid_argument("PSI resources must be 'cpu', 'memory' or 'io'");
+            }
+            if (!unique.insert(resource.get<std::string>()).second) {
+                throw std::invalid_argument("Duplicate PSI resources are not allowed");
+            }
+            names.push_back(resource.get<std::string>());
+        }
+    }
+
+    for (const auto &name : names) {
+        Resource resource;
+        resource.name = name;
+        std::string path = proc_root_ + "/pressure/" + name;
+        resource.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (resource.fd < 0) {
+            std::cerr << "PSI is unavailable for " << name << ": " << path << std::endl;
+        }
+        resources_.push_back(resource);
+    }
+
+    if (config.contains("triggers")) {
+        if (!config["triggers"].is_array()) {
+            throw std::invalid_argument("PSI 'triggers' must be an array");
+        }
+        for (const auto &trigger_config : config["triggers"]) {
+            std::string resource = trigger_config.value("resource", "");
+            auto it = std::find_if(resources_.begin(), resources_.end(),
+                                   [&](const Resource &r) { return r.name == resource; });
+            if (it == resources_.end()) {
+                throw std::invalid_argument("PSI trigger resource must be one of the monitored resources");
+            }
+
+            Trigger trigger;
+            trigger.resource = static_cast<size_t>(it - resources_.begin());
+            trigger.type = trigger_config.value("type", "some");
+            if (trigger.type != "some" && trigger.type != "full") {
+                throw std::invalid_argument("PSI trigger type must be 'some' or 'full'");
+            }
+            trigger.stall_us = trigger_config.value("stall_us", 0ull);
+            trigger.window_us = trigger_config.value("window_us", 1000000ull);
+            if (trigger.window_us < kMinWindowUs || trigger.window_us > kMaxWindowUs) {
+                throw std::invalid_argument("PSI trigger 'window_us' must be within 500000..10000000");
+            }
+            if (trigger.stall_us == 0 || trigger.stall_us > trigger.window_us) {
+                throw std::invalid_argument("PSI trigger 'stall_us' must be within 1..window_us");
+            }
+
+            register_trigger(trigger);
+            triggers_.push_back(trigger);
+        }
+    }
+}
+
+PSIMetric::~PSIMetric() {
+    if (watcher_.joinable()) {
+        uint64_t one = 1;
+        if (::write(wake_fd_, &one, sizeof(one)) < 0) {
+            // Поток всё равно проверит дескрипторы при следующем пробуждении
+        }
+        watcher_.join();
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+    }
+    for (const auto &trigger : triggers_) {
+        if (trigger.fd >= 0) {
+            close(trigger.fd);
+        }
+    }
+    for (const auto &resource : resources_) {
+        if (resource.fd >= 0) {
+            close(resource.fd);
+        }
+    }
+}
+
+void PSIMetric::register_trigger(Trigger &trigger) {
+    const Resource &resource = resources_[trigger.resource];
+    std::string spec = trigger.type + " " + std::to_string(trigger.stall_us) + " " +
+                       std::to_string(trigger.window_us);
+    trigger.fd = open_trigger_ ? open_trigger_(resource.name, spec)
+                               : open_kernel_trigger(proc_root_ + "/pressure/" + resource.name,
+                                                     resource.name, spec);
+}
+
+size_t PSIMetric::active_triggers() const {
+    return static_cast<size_t>(std::count_if(triggers_.begin(), triggers_.end(),
+                                             [](const Trigger &t) { return t.fd >= 0; }));
+}
+
+void PSIMetric::set_event_callback(EventCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback_ = std::move(callback);
+    }
+
+    // Поток ожидания нужен только при наличии триггеров и получателя
+    if (!watcher_.joinable() && active_triggers() > 0) {
+        wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (wake_fd_ >= 0) {
+            watcher_ = std::thread(&PSIMetric::watch_triggers, this);
+        }
+    }
+}
+
+void PSIMetric::watch_triggers() {
+    std::vector<pollfd> fds;
+    std::vector<const Trigger*> owners;
+    for (const auto &trigger : triggers_) {
+        if (trigger.fd >= 0) {
+            fds.push_back(pollfd{trigger.fd, POLLPRI, 0});
+            owners.push_back(&trigger);
+        }
+    }
+    fds.push_back(pollfd{wake_fd_, POLLIN, 0});
+    const size_t wake = fds.size() - 1;
+
+    while (true) {
+        int ready = poll(fds.data(), fds.size(), -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[wake].revents) {
+            return;
+        }
+
+        for (size_t i = 0; i < wake; ++i) {
+            if (fds[i].revents & POLLERR) {
+                // Ядро удалило триггер (например, вместе с cgroup)
+                fds[i].fd = -1;
+                continue;
+            }
+            if (!(fds[i].revents & POLLPRI)) {
+                continue;
+            }
+
+            const Trigger &trigger = *owners[i];
+            const Resource &resource = resources_[trigger.resource];
+            std::map<std::string, double> values;
+            read_resource(resource, values);
+            values[resource.name + "." + trigger.type + ".trigger"] = 1.0;
+
+            std::lock_guard<std::mutex> lock(callback_mutex_);
+            if (callback_) {
+                callback_(this, std::move(values));
+            }
+        }
+    }
+}
+
+void PSIMetric::read_resource(const Resource &resource, std::map<std::string, double> &out) const {
+    if (resource.fd < 0) {
+        return;
+    }
+
+    char buffer[256];
+    ssize_t size = pread(resource.fd, buffer, sizeof(buffer) - 1, 0);
+    if (size <= 0) {
+        return;
+    }
+    buffer[size] = '\0';
+
+    // Строки вида: some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    char *line = buffer;
+    while (line && *line) {
+        char *next = std::strchr(line, '\n');
+        if (next) {
+            *next++ = '\0';
+        }
+
+        char type[8] = {};
+        double avg10 = 0.0;
+        double avg60 = 0.0;
+        double avg300 = 0.0;
+        unsigned long long total = 0;
+        if (std::sscanf(line, "%7s avg10=%lf avg60=%lf avg300=%lf total=%llu", type, &avg10,
+                        &avg60, &avg300, &total) == 5) {
+            std::string prefix = resource.name + "." + type + ".";
+            out[prefix + "avg10"] = avg10;
+            out[prefix + "avg60"] = avg60;
+            out[prefix + "avg300"] = avg300;
+            out[prefix + "total"] = static_cast<double>(total);
+        }
+        line = next;
+    }
+}
+
+MetricValue PSIMetric::collect() const {
+    std::map<std::string, double> values;
+    for (const auto &resource : resources_) {
+        read_resource(resource, values);
+    }
+    return values;
+}
+
+bool PSIMetric::is_valid() const {
+    return !resources_.empty();
+}
+
+// Средние - доля времени простоя в процентах, total - суммарный простой в мкс
+const char* PSIMetric::unit(std::string_view key) const {
+    std::string_view field = key.substr(key.rfind('.') + 1);
+    if (field == "avg10" || field == "avg60" || field == "avg300") {
+        return "%";
+    }
+    return field == "total" ? "us" : "";
+}
+
+std::string PSIMetric::name() const {
+    return "psi";
+}
+
+STATUS_MONITOR_METRIC("psi", PSIMetric)
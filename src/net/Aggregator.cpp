@@ -0,0 +1,224 @@
+#include "net/Aggregator.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int kMaxEvents = 256;
+constexpr size_t kReadBufferSize = 64 * 1024;
+
+// Метрика удалённого узла: хранит только имя, значения приходят по сети
+class RemoteMetric : public IMetric {
+public:
+    explicit RemoteMetric(std::string name) : name_(std::move(name)) {}
+
+    MetricValue collect() const override { return MetricValue{}; }
+    bool is_valid() const override { return true; }
+    std::string name() const override { return name_; }
+
+private:
+    std::string name_;
+};
+
+} // namespace
+
+Aggregator::Aggregator(const json &config) : read_buffer_(kReadBufferSize) {
+    if (!config.contains("listen") || !config["listen"].is_string()) {
+        throw std::invalid_argument("Aggregator requires 'listen' address");
+    }
+    endpoint_ = Endpoint::parse(config["listen"].get<std::string>());
+
+    if (config.contains("max_connections")) {
+        if (!config["max_connections"].is_number_integer() ||
+            config["max_connections"].get<long long>() <= 0) {
+            throw std::invalid_argument("Aggregator 'max_connections' must be a positive integer");
+        }
+        max_connections_ = config["max_connections"].get<size_t>();
+    }
+
+    listen_fd_ = listen_endpoint(endpoint_, SOMAXCONN);
+    endpoint_ = bound_endpoint(listen_fd_, endpoint_);
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        close(listen_fd_);
+        throw std::runtime_error("Failed to create epoll: " + std::string(std::strerror(errno)));
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event);
+}
+
+Aggregator::~Aggregator() {
+    for (const auto &[fd, connection] : connections_) {
+        close(fd);
+    }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+    }
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        if (endpoint_.family == Endpoint::Family::Unix) {
+            unlink(endpoint_.path.c_str());
+        }
+    }
+}
+
+void Aggregator::poll(int timeout_ms) {
+    epoll_event events[kMaxEvents];
+    int ready = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return;
+        }
+        throw std::runtime_error("epoll_wait failed: " + std::string(std::strerror(errno)));
+    }
+
+    for (int i = 0; i < ready; ++i) {
+        int fd = events[i].data.fd;
+        if (fd == listen_fd_) {
+            accept_connections();
+        } else {
+            read_connection(fd);
+        }
+    }
+}
+
+void Aggregator::accept_connections() {
+    while (true) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        if (connections_.size() >= max_connections_) {
+            close(fd);
+            continue;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        connections_.emplace(fd, Connection{});
+    }
+}
+
+void Aggregator::read_connection(int fd) {
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+        return;
+    }
+    Connection &connection = it->second;
+
+    try {
+        while (true) {
+            ssize_t received = recv(fd, read_buffer_.data(), read_buffer_.size(), 0);
+            if (received < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return;
+                }
+                close_connection(fd);
+                return;
+            }
+            if (received == 0) {
+                close_connection(fd);
+                return;
+            }
+
+            connection.decoder.feed(read_buffer_.data(), static_cast<size_t>(received));
+            FrameDecoder::Frame frame;
+            while (connection.decoder.next(frame)) {
+                handle_frame(connection, frame);
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Dropping agent connection"
+                  << (connection.node.empty() ? "" : " from " + connection.node) << ": "
+                  << e.what() << std::endl;
+        close_connection(fd);
+    }
+}
+
+void Aggregator::handle_frame(Connection &connection, const FrameDecoder::Frame &frame) {
+    if (connection.node.empty() && frame.type != FrameType::Hello) {
+        throw std::runtime_error("Expected hello frame");
+    }
+
+    switch (frame.type) {
+    case FrameType::Hello:
+        if (!connection.node.empty()) {
+            throw std::runtime_error("Duplicate hello frame");
+        }
+        connection.node = StreamProtocol::decode_hello(frame.payload);
+        nodes_[connection.node];
+        break;
+
+    case FrameType::Schema: {
+        connection.schema = StreamProtocol::decode_schema(frame.payload);
+        connection.has_schema = true;
+
+        Node &node = nodes_[connection.node];
+        connection.metrics.clear();
+        for (const auto &entry : connection.schema.entries) {
+            auto &metric = node.metrics[entry.name];
+            if (!metric) {
+                metric = std::make_unique<RemoteMetric>(connection.node + "/" + entry.name);
+            }
+            connection.metrics.push_back(metric.get());
+        }
+        break;
+    }
+
+    case FrameType::Values: {
+        if (!connection.has_schema) {
+            throw std::runtime_error("Values frame before schema");
+        }
+        uint64_t timestamp_ms = StreamProtocol::decode_values(frame.payload, scratch_);
+        auto values = connection.schema.unpack(scratch_);
+
+        Node &node = nodes_[connection.node];
+        node.values.clear();
+        for (size_t i = 0; i < values.size(); ++i) {
+            node.values.emplace_back(connection.metrics[i], std::move(values[i]));
+        }
+        node.timestamp_ms = timestamp_ms;
+        node.updated = true;
+        break;
+    }
+    }
+}
+
+void Aggregator::close_connection(int fd) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections_.erase(fd);
+}
+
+std::vector<std::pair<const IMetric*, MetricValue>> Aggregator::collect() {
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values;
+    for (auto &[name, node] : nodes_) {
+        if (!node.updated) {
+            continue;
+        }
+        metric_values.insert(metric_values.end(), node.values.begin(), node.values.end());
+        node.updated = false;
+    }
+    return metric_values;
+}
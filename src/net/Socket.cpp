@@ -0,0 +1,198 @@
+#include "net/Socket.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+bool resolve(const Endpoint &endpoint, sockaddr_storage &address, socklen_t &length) {
+    std::memset(&address, 0, sizeof(address));
+
+    if (endpoint.family == Endpoint::Family::Unix) {
+        auto* un = reinterpret_cast<sockaddr_un*>(&address);
+        if (endpoint.path.size() >= sizeof(un->sun_path)) {
+            return false;
+        }
+        un->sun_family = AF_UNIX;
+        std::memcpy(un->sun_path, endpoint.path.c_str(), endpoint.path.size() + 1);
+        length = sizeof(sockaddr_un);
+        return true;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICSERV;
+    addrinfo* result = nullptr;
+    std::string port = std::to_string(endpoint.port);
+    if (getaddrinfo(endpoint.host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        return false;
+    }
+    std::memcpy(&address, result->ai_addr, result->ai_addrlen);
+    length = result->ai_addrlen;
+    freeaddrinfo(result);
+    return true;
+}
+
+} // namespace
+
+Endpoint Endpoint::parse(const std::string &address) {
+    Endpoint endpoint;
+
+    if (address.rfind("unix:", 0) == 0) {
+        endpoint.family = Family::Unix;
+        endpoint.path = address.substr(5);
+        // Допускаем и форму unix:///path
+        if (endpoint.path.rfind("//", 0) == 0) {
+            endpoint.path = endpoint.path.substr(2);
+        }
+        if (endpoint.path.empty()) {
+            throw std::invalid_argument("Unix socket address requires a path: " + address);
+        }
+        return endpoint;
+    }
+
+    if (address.rfind("tcp://", 0) != 0) {
+        throw std::invalid_argument("Unsupported stream address: " + address);
+    }
+
+    std::string rest = address.substr(6);
+    size_t colon = rest.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == rest.size()) {
+        throw std::invalid_argument("TCP address must be tcp://host:port: " + address);
+    }
+    endpoint.host = rest.substr(0, colon);
+    // IPv6 в квадратных скобках: tcp://[::1]:9100
+    if (endpoint.host.size() > 2 && endpoint.host.front() == '[' && endpoint.host.back() == ']') {
+        endpoint.host = endpoint.host.substr(1, endpoint.host.size() - 2);
+    }
+
+    int port = 0;
+    try {
+        size_t parsed = 0;
+        port = std::stoi(rest.substr(colon + 1), &parsed);
+        if (parsed != rest.size() - colon - 1) {
+            port = -1;
+        }
+    } catch (const std::exception &) {
+        port = -1;
+    }
+    if (port < 0 || port > 65535) {
+        throw std::invalid_argument("Invalid TCP port in address: " + address);
+    }
+    endpoint.port = static_cast<uint16_t>(port);
+    return endpoint;
+}
+
+std::string Endpoint::to_string() const {
+    if (family == Family::Unix) {
+        return "unix:" + path;
+    }
+    if (host.find(':') != std::string::npos) {
+        return "tcp://[" + host + "]:" + std::to_string(port);
+    }
+    return "tcp://" + host + ":" + std::to_string(port);
+}
+
+bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int connect_endpoint(const Endpoint &endpoint) {
+    sockaddr_storage address;
+    socklen_t length = 0;
+    if (!resolve(endpoint, address, length)) {
+        return -1;
+    }
+
+    int fd = socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (endpoint.family == Endpoint::Family::Tcp) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), length) != 0 &&
+        errno != EINPROGRESS) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int check_connected(int fd) {
+    pollfd pfd{fd, POLLOUT, 0};
+    int ready = poll(&pfd, 1, 0);
+    if (ready == 0) {
+        return 0;
+    }
+    if (ready < 0) {
+        return -1;
+    }
+
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+        return -1;
+    }
+    return 1;
+}
+
+int listen_endpoint(const Endpoint &endpoint, int backlog) {
+    sockaddr_storage address;
+    socklen_t length = 0;
+    if (!resolve(endpoint, address, length)) {
+        throw std::runtime_error("Failed to resolve listen address: " + endpoint.to_string());
+    }
+
+    int fd = socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create socket: " + std::string(std::strerror(errno)));
+    }
+
+    if (endpoint.family == Endpoint::Family::Unix) {
+        unlink(endpoint.path.c_str());
+    } else {
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+        listen(fd, backlog) != 0) {
+        std::string error = std::strerror(errno);
+        close(fd);
+        throw std::runtime_error("Failed to listen on " + endpoint.to_string() + ": " + error);
+    }
+    return fd;
+}
+
+Endpoint bound_endpoint(int fd, const Endpoint &endpoint) {
+    Endpoint bound = endpoint;
+    if (endpoint.family != Endpoint::Family::Tcp) {
+        return bound;
+    }
+
+    sockaddr_storage address;
+    socklen_t length = sizeof(address);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+        if (address.ss_family == AF_INET) {
+            bound.port = ntohs(reinterpret_cast<sockaddr_in*>(&address)->sin_port);
+        } else if (address.ss_family == AF_INET6) {
+            bound.port = ntohs(reinterpret_cast<sockaddr_in6*>(&address)->sin6_port);
+        }
+    }
+    return bound;
+}
@@ -0,0 +1,379 @@
+#include "net/StreamProtocol.hpp"
+#include "metrics/MetricSeries.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+void put_u8(std::string &out, uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+void put_u16(std::string &out, uint16_t value) {
+    char bytes[2] = {static_cast<char>(value), static_cast<char>(value >> 8)};
+    out.append(bytes, sizeof(bytes));
+}
+
+void put_u32(std::string &out, uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(bytes, sizeof(bytes));
+}
+
+void put_u64(std::string &out, uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(bytes, sizeof(bytes));
+}
+
+void put_f64(std::string &out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u64(out, bits);
+}
+
+void put_string(std::string &out, std::string_view text) {
+    if (text.size() > UINT16_MAX) {
+        throw std::length_error("String is too long for stream protocol");
+    }
+    put_u16(out, static_cast<uint16_t>(text.size()));
+    out.append(text.data(), text.size());
+}
+
+// Начинает кадр и возвращает позицию поля длины
+size_t begin_frame(std::string &out, FrameType type) {
+    size_t position = out.size();
+    put_u32(out, 0);
+    put_u8(out, static_cast<uint8_t>(type));
+    return position;
+}
+
+void end_frame(std::string &out, size_t position) {
+    size_t payload = out.size() - position - StreamProtocol::kHeaderSize;
+    if (payload > StreamProtocol::kMaxPayload) {
+        throw std::length_error("Stream frame is too large");
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[position + i] = static_cast<char>(payload >> (8 * i));
+    }
+}
+
+// Последовательное чтение нагрузки с проверкой границ
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data) {}
+
+    uint8_t u8() { return static_cast<uint8_t>(take(1)[0]); }
+
+    uint16_t u16() {
+        const char* p = take(2);
+        return static_cast<uint16_t>(byte(p, 0) | (byte(p, 1) << 8));
+    }
+
+    uint32_t u32() {
+        const char* p = take(4);
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(byte(p, i)) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t u64() {
+        const char* p = take(8);
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(byte(p, i)) << (8 * i);
+        }
+        return value;
+    }
+
+    double f64() {
+        uint64_t bits = u64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string string() {
+        uint16_t size = u16();
+        return std::string(take(size), size);
+    }
+
+    size_t remaining() const { return data_.size() - offset_; }
+
+    void finish() const {
+        if (remaining() != 0) {
+            throw std::runtime_error("Trailing bytes in stream frame");
+        }
+    }
+
+private:
+    static uint32_t byte(const char* p, int i) {
+        return static_cast<unsigned char>(p[i]);
+    }
+
+    const char* take(size_t size) {
+        if (remaining() < size) {
+            throw std::runtime_error("Truncated stream frame");
+        }
+        const char* p = data_.data() + offset_;
+        offset_ += size;
+        return p;
+    }
+
+    std::string_view data_;
+    size_t offset_ = 0;
+};
+
+StreamSchema::Kind kind_of(const MetricValue &value) {
+    if (std::holds_alternative<std::map<std::string, double>>(value)) {
+        return StreamSchema::Kind::Map;
+    }
+    if (std::holds_alternative<std::vector<int>>(value) ||
+        std::holds_alternative<std::vector<double>>(value)) {
+        return StreamSchema::Kind::Vector;
+    }
+    return StreamSchema::Kind::Scalar;
+}
+
+uint32_t count_of(const MetricValue &value) {
+    return static_cast<uint32_t>(series_count(value));
+}
+
+} // namespace
+
+StreamSchema StreamSchema::from(
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    StreamSchema schema;
+    for (const auto &[metric, value] : metric_values) {
+        Entry entry;
+        entry.name = metric->name();
+        entry.metric = metric;
+        entry.kind = kind_of(value);
+        entry.count = count_of(value);
+        if (entry.kind == Kind::Map) {
+            for (const auto &[key, v] : std::get<std::map<std::string, double>>(value)) {
+                entry.keys.push_back(key);
+            }
+        }
+        schema.entries.push_back(std::move(entry));
+    }
+    return schema;
+}
+
+bool StreamSchema::matches(
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) const {
+    if (entries.size() != metric_values.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Entry &entry = entries[i];
+        const auto &[metric, value] = metric_values[i];
+        if (entry.kind != kind_of(value) || entry.count != count_of(value) ||
+            (entry.metric != metric && entry.name != metric->name())) {
+            return false;
+        }
+        if (entry.kind == Kind::Map) {
+            size_t k = 0;
+            for (const auto &[key, v] : std::get<std::map<std::string, double>>(value)) {
+                if (entry.keys[k++] != key) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+uint64_t StreamSchema::series_count() const {
+    // Сумма в 64 битах: счётчики из сети не должны переполнить её до проверки
+    uint64_t count = 0;
+    for (const auto &entry : entries) {
+        count += entry.count;
+    }
+    return count;
+}
+
+std::vector<MetricValue> StreamSchema::unpack(const std::vector<double> &values) const {
+    if (values.size() != series_count()) {
+        throw std::runtime_error("Values do not match stream schema");
+    }
+
+    std::vector<MetricValue> result;
+    result.reserve(entries.size());
+    size_t offset = 0;
+    for (const auto &entry : entries) {
+        if (entry.count > values.size() - offset) {
+            throw std::runtime_error("Values do not match stream schema");
+        }
+        switch (entry.kind) {
+        case Kind::Scalar:
+            result.emplace_back(values[offset]);
+            break;
+        case Kind::Vector:
+            result.emplace_back(std::vector<double>(values.begin() + offset,
+                                                    values.begin() + offset + entry.count));
+            break;
+        case Kind::Map: {
+            std::map<std::string, double> map;
+            for (uint32_t i = 0; i < entry.count; ++i) {
+                map[entry.keys[i]] = values[offset + i];
+            }
+            result.emplace_back(std::move(map));
+            break;
+        }
+        }
+        offset += entry.count;
+    }
+    return result;
+}
+
+void StreamProtocol::encode_hello(std::string &out, std::string_view node) {
+    size_t frame = begin_frame(out, FrameType::Hello);
+    put_u16(out, kVersion);
+    put_string(out, node);
+    end_frame(out, frame);
+}
+
+void StreamProtocol::encode_schema(std::string &out, const StreamSchema &schema) {
+    size_t frame = begin_frame(out, FrameType::Schema);
+    put_u16(out, static_cast<uint16_t>(schema.entries.size()));
+    for (const auto &entry : schema.entries) {
+        put_string(out, entry.name);
+        put_u8(out, static_cast<uint8_t>(entry.kind));
+        put_u32(out, entry.count);
+        for (const auto &key : entry.keys) {
+            put_string(out, key);
+        }
+    }
+    end_frame(out, frame);
+}
+
+void StreamProtocol::encode_values(
+    std::string &out, uint64_t timestamp_ms,
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    size_t frame = begin_frame(out, FrameType::Values);
+    put_u64(out, timestamp_ms);
+    size_t count_position = out.size();
+    put_u32(out, 0);
+
+    uint32_t count = 0;
+    for (const auto &[metric, value] : metric_values) {
+        for_each_value(value, [&](double v) {
+            put_f64(out, v);
+            ++count;
+        });
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[count_position + i] = static_cast<char>(count >> (8 * i));
+    }
+    end_frame(out, frame);
+}
+
+std::string StreamProtocol::decode_hello(std::string_view payload) {
+    Reader reader(payload);
+    if (reader.u16() != kVersion) {
+        throw std::runtime_error("Unsupported stream protocol version");
+    }
+    std::string node = reader.string();
+    reader.finish();
+    if (node.empty()) {
+        throw std::runtime_error("Empty node name in stream hello");
+    }
+    return node;
+}
+
+StreamSchema StreamProtocol::decode_schema(std::string_view payload) {
+    Reader reader(payload);
+    StreamSchema schema;
+    uint64_t total = 0;
+    uint16_t entries = reader.u16();
+    for (uint16_t i = 0; i < entries; ++i) {
+        StreamSchema::Entry entry;
+        entry.name = reader.string();
+        uint8_t kind = reader.u8();
+        if (kind > static_cast<uint8_t>(StreamSchema::Kind::Map)) {
+            throw std::runtime_error("Unknown metric kind in stream schema");
+        }
+        entry.kind = static_cast<StreamSchema::Kind>(kind);
+        entry.count = reader.u32();
+        if (entry.kind == StreamSchema::Kind::Scalar && entry.count != 1) {
+            throw std::runtime_error("Scalar metric must have one series");
+        }
+        // Все ряды должны помещаться в один кадр значений
+        total += entry.count;
+        if (total > StreamProtocol::kMaxPayload / sizeof(double)) {
+            throw std::runtime_error("Too many series in stream schema");
+        }
+        if (entry.kind == StreamSchema::Kind::Map) {
+            // Каждый ключ занимает минимум два байта
+            if (entry.count > reader.remaining() / 2) {
+                throw std::runtime_error("Truncated stream frame");
+            }
+            for (uint32_t k = 0; k < entry.count; ++k) {
+                entry.keys.push_back(reader.string());
+            }
+        }
+        schema.entries.push_back(std::move(entry));
+    }
+    reader.finish();
+    return schema;
+}
+
+uint64_t StreamProtocol::decode_values(std::string_view payload, std::vector<double> &values) {
+    Reader reader(payload);
+    uint64_t timestamp_ms = reader.u64();
+    uint32_t count = reader.u32();
+    if (reader.remaining() != static_cast<size_t>(count) * sizeof(double)) {
+        throw std::runtime_error("Truncated stream frame");
+    }
+    values.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        values[i] = reader.f64();
+    }
+    return timestamp_ms;
+}
+
+void FrameDecoder::feed(const char* data, size_t size) {
+    // Отбрасываем уже разобранные кадры перед добавлением новых данных
+    if (offset_ > 0) {
+        buffer_.erase(0, offset_);
+        offset_ = 0;
+    }
+    buffer_.append(data, size);
+}
+
+bool FrameDecoder::next(Frame &frame) {
+    size_t available = buffer_.size() - offset_;
+    if (available < StreamProtocol::kHeaderSize) {
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const unsigned char*>(buffer_.data() + offset_);
+    uint32_t payload = 0;
+    for (int i = 0; i < 4; ++i) {
+        payload |= static_cast<uint32_t>(header[i]) << (8 * i);
+    }
+    if (payload > StreamProtocol::kMaxPayload) {
+        throw std::runtime_error("Stream frame is too large");
+    }
+    uint8_t type = header[4];
+    if (type < static_cast<uint8_t>(FrameType::Hello) ||
+        type > static_cast<uint8_t>(FrameType::Values)) {
+        throw std::runtime_error("Unknown stream frame type");
+    }
+    if (available < StreamProtocol::kHeaderSize + payload) {
+        return false;
+    }
+
+    frame.type = static_cast<FrameType>(type);
+    frame.payload = std::string_view(buffer_.data() + offset_ + StreamProtocol::kHeaderSize,
+                                     payload);
+    offset_ += StreamProtocol::kHeaderSize + payload;
+    return true;
+}
@@ -1,31 +1,26 @@
 #include "output/ConsoleOutput.hpp"
-#include <chrono>
 #include <cstdlib>
-#include <ctime>
 #include <iomanip>
 #include <iostream>
-#include <sstream>
 
 ConsoleOutput::ConsoleOutput(const json &config) {
-    // В будущем здесь может быть дополнительная конфигурация
-    // Например, формат вывода
+    if (config.contains("deadband")) {
+        deadband_ = Deadband(config["deadband"]);
+    }
 }
 
 void ConsoleOutput::write(
+    const Timestamp &tick,
     const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
-    std::system("clear");
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-
-    std::stringstream ss;
-    ss << std::ctime(&time);
-    std::string time_str = ss.str();
-
-    // Перед выводом заголовка убераем перенос строки
-    if (!time_str.empty() && time_str.back() == '\n') {
-        time_str.pop_back();
+    // В режиме deadband не перерисовываем экран, если ничего не изменилось.
+    // Иначе экран перерисовывается целиком: ряды без изменений показывают
+    // последнее выведенное значение, чтобы не пропадать с экрана
+    if (deadband_.enabled() && deadband_.evaluate(tick.monotonic_ns, metric_values) == 0) {
+        return;
     }
-    std::cout << "=== System Metrics at " << time_str << " ===\n\n";
+
+    std::system("clear");
+    std::cout << "=== System Metrics at " << formatter_.format(tick.realtime_ns) << " ===\n\n";
 
     for (const auto &[metric, value] : metric_values) {
         if (metric->is_valid()) {
@@ -49,13 +44,15 @@ void ConsoleOutput::print_metric(const IMetric* metric, const MetricValue &value
         auto usage = std::get<std::vector<double>>(value);
         for (size_t i = 0; i < usage.size(); ++i) {
             std::cout << "CPU " << i << ": " << std::fixed << std::setprecision(2)
-                    << usage[i] << "%\n";
+                    << deadband_.shown(metric, i, usage[i]) << "%\n";
         }
     } else if (std::holds_alternative<std::map<std::string, double>>(value)) {
         auto memory = std::get<std::map<std::string, double>>(value);
+        size_t index = 0;
         for (const auto &[key, val] : memory) {
-            std::cout << key << ": " << std::fixed << std::setprecision(2) << val
-                    << " MB\n";
+            std::cout << key << ": " << std::fixed << std::setprecision(2)
+                    << deadband_.shown(metric, index++, val)
+                    << unit_suffix(metric->unit(key)) << "\n";
         }
     }
 }
@@ -0,0 +1,138 @@
+#include "output/Deadband.hpp"
+#include "metrics/MetricSeries.hpp"
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+double read_threshold(const json &config, const char *key) {
+    if (!config.contains(key)) {
+        return 0.0;
+    }
+    if (!config[key].is_number()) {
+        throw std::invalid_argument(std::string("Deadband '") + key + "' must be a number");
+    }
+    double value = config[key].get<double>();
+    if (value < 0.0) {
+        throw std::invalid_argument(std::string("Deadband '") + key + "' must be non-negative");
+    }
+    return value;
+}
+
+} // namespace
+
+Deadband::Deadband(const json &config) : enabled_(true) {
+    if (!config.is_object()) {
+        throw std::invalid_argument("Deadband config must be an object");
+    }
+    abs_eps_ = read_threshold(config, "abs");
+    rel_eps_ = read_threshold(config, "rel");
+    heartbeat_ns_ = static_cast<int64_t>(read_threshold(config, "heartbeat") * 1e9);
+}
+
+size_t Deadband::evaluate(
+    int64_t monotonic_ns,
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    now_ns_ = monotonic_ns;
+
+    size_t emitted = 0;
+    for (const auto &[metric, value] : metric_values) {
+        if (metric->is_valid()) {
+            emitted += update(metric, value);
+        }
+    }
+    return emitted;
+}
+
+bool Deadband::pass(SeriesState &state, double value) const {
+    if (!state.seen) {
+        return true;
+    }
+    if (heartbeat_ns_ > 0 && now_ns_ - state.last_emit_ns >= heartbeat_ns_) {
+        return true;
+    }
+
+    double delta = std::fabs(value - state.last);
+    if (abs_eps_ == 0.0 && rel_eps_ == 0.0) {
+        return delta != 0.0;
+    }
+    return (abs_eps_ > 0.0 && delta > abs_eps_) ||
+           (rel_eps_ > 0.0 && delta > rel_eps_ * std::fabs(state.last));
+}
+
+size_t Deadband::update(const IMetric* metric, const MetricValue &value) {
+    auto &metric_state = metrics_[metric];
+    bool is_map = std::holds_alternative<std::map<std::string, double>>(value);
+    size_t count = series_count(value);
+    if (!is_map && metric_state.indexed.size() != count) {
+        metric_state.indexed.resize(count);
+    }
+    metric_state.emit.assign(count, 0);
+    metric_state.shown.resize(count);
+    ++round_;
+
+    size_t emitted_count = 0;
+    for_each_series(value, [&](size_t index, std::string_view key, double val) {
+        SeriesState* state = nullptr;
+        if (is_map) {
+            auto it = metric_state.keyed.find(key);
+            if (it == metric_state.keyed.end()) {
+                it = metric_state.keyed.emplace(std::string(key), SeriesState{}).first;
+            }
+            state = &it->second;
+        } else {
+            state = &metric_state.indexed[index];
+        }
+        state->round = round_;
+
+        bool emit = !enabled_ || pass(*state, val);
+        metric_state.emit[index] = emit;
+        if (emit) {
+            // Храним последнее выведенное значение, а не последнее измеренное,
+            // иначе медленный дрейф никогда не превысит порог
+            state->last = val;
+            state->last_emit_ns = now_ns_;
+            state->seen = true;
+            ++emitted_count;
+        }
+        metric_state.shown[index] = state->last;
+    });
+
+    // Исчезнувшие ключи забываются, чтобы не копить состояние пересоздаваемых устройств
+    if (metric_state.keyed.size() > (is_map ? count : 0)) {
+        for (auto it = metric_state.keyed.begin(); it != metric_state.keyed.end();) {
+            it = it->second.round == round_ ? std::next(it) : metric_state.keyed.erase(it);
+        }
+    }
+
+    metric_state.emitted = emitted_count;
+    return emitted_count;
+}
+
+bool Deadband::emitted(const IMetric* metric, size_t index) const {
+    if (!enabled_) {
+        return true;
+    }
+    auto it = metrics_.find(metric);
+    if (it == metrics_.end() || index >= it->second.emit.size()) {
+        return false;
+    }
+    return it->second.emit[index] != 0;
+}
+
+size_t Deadband::emitted_count(const IMetric* metric) const {
+    auto it = metrics_.find(metric);
+    return it == metrics_.end() ? 0 : it->second.emitted;
+}
+
+double Deadband::shown(const IMetric* metric, size_t index, double value) const {
+    if (!enabled_) {
+        return value;
+    }
+    auto it = metrics_.find(metric);
+    if (it == metrics_.end() || index >= it->second.shown.size()) {
+        return value;
+    }
+    return it->second.shown[index];
+}
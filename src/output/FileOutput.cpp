@@ -1,9 +1,6 @@
 #include "output/FileOutput.hpp"
-#include <chrono>
-#include <ctime>
 #include <fstream>
 #include <iomanip>
-#include <sstream>
 
 FileOutput::FileOutput(const json &config) {
     if (config.contains("file") && config["file"].is_string()) {
@@ -12,6 +9,10 @@ FileOutput::FileOutput(const json &config) {
         file_path_ = config["path"].get<std::string>();
     }
 
+    if (config.contains("deadband")) {
+        deadband_ = Deadband(config["deadband"]);
+    }
+
     if (!file_path_.empty()) {
         file_.open(file_path_, std::ios::app);
     }
@@ -23,24 +24,21 @@ FileOutput::~FileOutput() {
     }
 }
 
-void FileOutput::write(const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+void FileOutput::write(const Timestamp &tick, const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
     if (!file_.is_open()) {
         return;
     }
 
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-
-    std::stringstream ss;
-    ss << std::ctime(&time);
-    std::string time_str = ss.str();
-    if (!time_str.empty() && time_str.back() == '\n') {
-        time_str.pop_back();
+    // В режиме deadband пропускаем тик целиком, если ничего не изменилось
+    if (deadband_.enabled() && deadband_.evaluate(tick.monotonic_ns, metric_values) == 0) {
+        return;
     }
-    file_ << "\n=== Metrics at " << time_str << " ===\n";
+
+    file_ << "\n=== Metrics at " << formatter_.format(tick.realtime_ns) << " ===\n";
 
     for (const auto &[metric, value] : metric_values) {
-        if (metric->is_valid()) {
+        if (metric->is_valid() &&
+            (!deadband_.enabled() || deadband_.emitted_count(metric) > 0)) {
             write_metric(metric, value);
         }
     }
@@ -57,14 +55,21 @@ void FileOutput::write_metric(const IMetric* metric, const MetricValue &value) {
     if (std::holds_alternative<std::vector<double>>(value)) {
         auto usage = std::get<std::vector<double>>(value);
         for (size_t i = 0; i < usage.size(); ++i) {
+            if (!deadband_.emitted(metric, i)) {
+                continue;
+            }
             file_ << "CPU " << i << ": " << std::fixed << std::setprecision(2)
                 << usage[i] << "%\n";
         }
     } else if (std::holds_alternative<std::map<std::string, double>>(value)) {
         auto memory = std::get<std::map<std::string, double>>(value);
+        size_t index = 0;
         for (const auto &[key, val] : memory) {
+            if (!deadband_.emitted(metric, index++)) {
+                continue;
+            }
             file_ << key << ": " << std::fixed << std::setprecision(2) << val
-                << " MB\n";
+                << unit_suffix(metric->unit(key)) << "\n";
         }
     }
 }
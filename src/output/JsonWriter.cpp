@@ -0,0 +1,125 @@
+#include "output/JsonWriter.hpp"
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+JsonWriter::JsonWriter(size_t reserve) {
+    buffer_.reserve(reserve);
+}
+
+void JsonWriter::clear() {
+    buffer_.clear();
+    depth_ = 0;
+    has_items_[0] = false;
+    after_key_ = false;
+}
+
+void JsonWriter::separator() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (has_items_[depth_]) {
+        buffer_.push_back(',');
+    }
+    has_items_[depth_] = true;
+}
+
+void JsonWriter::open(char c) {
+    separator();
+    if (depth_ + 1 >= kMaxDepth) {
+        throw std::length_error("JSON nesting is too deep");
+    }
+    buffer_.push_back(c);
+    has_items_[++depth_] = false;
+}
+
+void JsonWriter::close(char c) {
+    buffer_.push_back(c);
+    if (depth_ > 0) {
+        --depth_;
+    }
+}
+
+void JsonWriter::begin_object() { open('{'); }
+void JsonWriter::end_object() { close('}'); }
+void JsonWriter::begin_array() { open('['); }
+void JsonWriter::end_array() { close(']'); }
+
+void JsonWriter::key(std::string_view name) {
+    separator();
+    escape(name);
+    buffer_.push_back(':');
+    after_key_ = true;
+}
+
+void JsonWriter::value(double number) {
+    // JSON не поддерживает NaN и бесконечности
+    if (!std::isfinite(number)) {
+        null();
+        return;
+    }
+    separator();
+    char chars[32];
+    auto result = std::to_chars(chars, chars + sizeof(chars), number);
+    buffer_.append(chars, result.ptr);
+}
+
+void JsonWriter::value(int64_t number) {
+    separator();
+    char chars[24];
+    auto result = std::to_chars(chars, chars + sizeof(chars), number);
+    buffer_.append(chars, result.ptr);
+}
+
+void JsonWriter::value(std::string_view text) {
+    separator();
+    escape(text);
+}
+
+void JsonWriter::boolean(bool flag) {
+    separator();
+    if (flag) {
+        buffer_.append("true", 4);
+    } else {
+        buffer_.append("false", 5);
+    }
+}
+
+void JsonWriter::null() {
+    separator();
+    buffer_.append("null", 4);
+}
+
+void JsonWriter::escape(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+
+    buffer_.push_back('"');
+    // Копируем участки без спецсимволов целиком
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        buffer_.append(text.data() + start, i - start);
+        start = i + 1;
+
+        switch (c) {
+        case '"': buffer_.append("\\\"", 2); break;
+        case '\\': buffer_.append("\\\\", 2); break;
+        case '\n': buffer_.append("\\n", 2); break;
+        case '\r': buffer_.append("\\r", 2); break;
+        case '\t': buffer_.append("\\t", 2); break;
+        case '\b': buffer_.append("\\b", 2); break;
+        case '\f': buffer_.append("\\f", 2); break;
+        default: {
+            char code[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+            buffer_.append(code, sizeof(code));
+        }
+        }
+    }
+    buffer_.append(text.data() + start, text.size() - start);
+    buffer_.push_back('"');
+}
@@ -0,0 +1,132 @@
+#include "output/JsonlOutput.hpp"
+#include <algorithm>
+
+namespace {
+
+void write_value(JsonWriter &writer, const MetricValue &value) {
+    if (std::holds_alternative<int>(value)) {
+        writer.value(std::get<int>(value));
+    } else if (std::holds_alternative<double>(value)) {
+        writer.value(std::get<double>(value));
+    } else if (std::holds_alternative<std::vector<int>>(value)) {
+        writer.begin_array();
+        for (int v : std::get<std::vector<int>>(value)) {
+            writer.value(v);
+        }
+        writer.end_array();
+    } else if (std::holds_alternative<std::vector<double>>(value)) {
+        writer.begin_array();
+        for (double v : std::get<std::vector<double>>(value)) {
+            writer.value(v);
+        }
+        writer.end_array();
+    } else if (std::holds_alternative<std::map<std::string, double>>(value)) {
+        writer.begin_object();
+        for (const auto &[key, v] : std::get<std::map<std::string, double>>(value)) {
+            writer.key(key);
+            writer.value(v);
+        }
+        writer.end_object();
+    }
+}
+
+bool is_reserved(const std::string &key) {
+    return key == "timestamp" || key == "event";
+}
+
+} // namespace
+
+const std::vector<std::string> &JsonlOutput::MetricKeys::update(
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    bool same = metrics_.size() == metric_values.size();
+    for (size_t i = 0; same && i < metric_values.size(); ++i) {
+        same = metrics_[i] == metric_values[i].first;
+    }
+    if (same) {
+        return keys_;
+    }
+
+    metrics_.clear();
+    keys_.clear();
+    for (const auto &[metric, value] : metric_values) {
+        std::string name = metric->name();
+        std::string key = name;
+        for (int n = 2;
+             is_reserved(key) || std::find(keys_.begin(), keys_.end(), key) != keys_.end(); ++n) {
+            key = name + "#" + std::to_string(n);
+        }
+        metrics_.push_back(metric);
+        keys_.push_back(std::move(key));
+    }
+    return keys_;
+}
+
+std::string JsonlOutput::MetricKeys::key_of(const IMetric* metric) const {
+    auto it = std::find(metrics_.begin(), metrics_.end(), metric);
+    return it != metrics_.end() ? keys_[it - metrics_.begin()] : metric->name();
+}
+
+JsonlOutput::JsonlOutput(const json &config) {
+    if (config.contains("path") && config["path"].is_string()) {
+        file_path_ = config["path"].get<std::string>();
+    }
+
+    if (!file_path_.empty()) {
+        file_.open(file_path_, std::ios::app);
+    }
+}
+
+JsonlOutput::~JsonlOutput() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+void JsonlOutput::serialize(
+    JsonWriter &writer, int64_t timestamp_ms,
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values, MetricKeys &keys,
+    bool event) {
+    const std::vector<std::string>* names = event ? nullptr : &keys.update(metric_values);
+    writer.begin_object();
+    writer.key("timestamp");
+    writer.value(timestamp_ms);
+    if (event) {
+        writer.key("event");
+        writer.boolean(true);
+    }
+    for (size_t i = 0; i < metric_values.size(); ++i) {
+        const auto &[metric, value] = metric_values[i];
+        if (metric->is_valid()) {
+            writer.key(names ? (*names)[i] : keys.key_of(metric));
+            write_value(writer, value);
+        }
+    }
+    writer.end_object();
+}
+
+void JsonlOutput::write(const Timestamp &tick, const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    write_line(tick, metric_values, false);
+}
+
+void JsonlOutput::write_event(const Timestamp &tick, const IMetric* metric,
+                              const MetricValue &value) {
+    write_line(tick, {{metric, value}}, true);
+}
+
+void JsonlOutput::write_line(
+    const Timestamp &tick,
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values, bool event) {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    int64_t timestamp_ms = tick.realtime_ms();
+    writer_.clear();
+    serialize(writer_, timestamp_ms, metric_values, keys_, event);
+    writer_.raw('\n');
+
+    file_.write(writer_.data(), static_cast<std::streamsize>(writer_.size()));
+    file_.flush();
+}
+
+bool JsonlOutput::is_valid() const { return file_.is_open(); }
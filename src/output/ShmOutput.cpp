@@ -0,0 +1,227 @@
+#include "output/ShmOutput.hpp"
+#include "metrics/MetricSeries.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kMaxCapacity = 1 << 20;
+
+void copy_name(shm_snapshot::Series &series, const std::string &name) {
+    size_t length = std::min(name.size(), shm_snapshot::kNameSize - 1);
+    std::memcpy(series.name, name.data(), length);
+    std::memset(series.name + length, 0, shm_snapshot::kNameSize - length);
+}
+
+} // namespace
+
+ShmOutput::ShmOutput(const json &config) {
+    if (!config.contains("name") || !config["name"].is_string()) {
+        return;
+    }
+    name_ = config["name"].get<std::string>();
+    if (name_.size() < 2 || name_[0] != '/' || name_.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument("Shm output 'name' must look like '/segment'");
+    }
+
+    if (config.contains("capacity")) {
+        if (!config["capacity"].is_number_integer() ||
+            config["capacity"].get<long long>() <= 0 ||
+            config["capacity"].get<long long>() > kMaxCapacity) {
+            throw std::invalid_argument("Shm output 'capacity' must be an integer in 1.." +
+                                        std::to_string(kMaxCapacity));
+        }
+        capacity_ = config["capacity"].get<uint32_t>();
+    }
+    if (config.contains("unlink")) {
+        if (!config["unlink"].is_boolean()) {
+            throw std::invalid_argument("Shm output 'unlink' must be a boolean");
+        }
+        unlink_ = config["unlink"].get<bool>();
+    }
+
+    int fd = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("shm_open " + name_ + ": " + std::strerror(errno));
+    }
+    size_ = shm_snapshot::segment_size(capacity_);
+    if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        int error = errno;
+        close(fd);
+        throw std::runtime_error("ftruncate " + name_ + ": " + std::strerror(error));
+    }
+    void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("mmap " + name_ + ": " + std::strerror(errno));
+    }
+
+    // Сегмент мог остаться от прошлого запуска, и к нему уже могут быть
+    // подключены читатели. Заголовок меняется под нечётным номером, как
+    // обычная запись, а sequence и schema_generation продолжаются: иначе
+    // читатель принял бы новые данные за старый снимок, а новую схему -
+    // за уже прочитанную. Новый сегмент обнуляется, magic выставляется последним.
+    char* base = static_cast<char*>(data);
+    header_ = reinterpret_cast<shm_snapshot::Header*>(base);
+    series_ = reinterpret_cast<shm_snapshot::Series*>(base + sizeof(shm_snapshot::Header));
+    values_ = reinterpret_cast<double*>(base + sizeof(shm_snapshot::Header) +
+                                        capacity_ * sizeof(shm_snapshot::Series));
+
+    bool reused = header_->magic == shm_snapshot::kMagic;
+    if (!reused) {
+        std::memset(base, 0, sizeof(shm_snapshot::Header));
+    }
+    uint64_t sequence = header_->sequence.load(std::memory_order_relaxed) | 1;
+    header_->sequence.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header_->version = shm_snapshot::kVersion;
+    header_->header_size = sizeof(shm_snapshot::Header);
+    header_->capacity = capacity_;
+    header_->count = 0;
+    header_->schema_offset = sizeof(shm_snapshot::Header);
+    header_->values_offset = header_->schema_offset + capacity_ * sizeof(shm_snapshot::Series);
+    ++header_->schema_generation;
+
+    header_->sequence.store(sequence + 1, std::memory_order_release);
+    if (!reused) {
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->magic = shm_snapshot::kMagic;
+    }
+}
+
+ShmOutput::~ShmOutput() {
+    if (header_) {
+        munmap(header_, size_);
+        if (unlink_) {
+            shm_unlink(name_.c_str());
+        }
+    }
+}
+
+bool ShmOutput::is_valid() const { return header_ != nullptr; }
+
+void ShmOutput::publish_schema() {
+    uint32_t index = 0;
+    for (const auto &entry : schema_.entries) {
+        for (uint32_t i = 0; i < entry.count; ++i) {
+            if (index == capacity_) {
+                return;
+            }
+            if (entry.kind == StreamSchema::Kind::Scalar) {
+                copy_name(series_[index++], entry.name);
+            } else if (entry.kind == StreamSchema::Kind::Map) {
+                copy_name(series_[index++], entry.name + "/" + entry.keys[i]);
+            } else {
+                copy_name(series_[index++], entry.name + "/" + std::to_string(i));
+            }
+        }
+    }
+}
+
+void ShmOutput::write(const Timestamp &tick,
+                      const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    if (!header_) {
+        return;
+    }
+
+    bool schema_changed = !has_schema_ || !schema_.matches(metric_values);
+    if (schema_changed) {
+        schema_ = StreamSchema::from(metric_values);
+        has_schema_ = true;
+    }
+
+    // Начало записи: нечётный номер говорит читателям повторить попытку
+    uint64_t sequence = header_->sequence.load(std::memory_order_relaxed);
+    header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (schema_changed) {
+        publish_schema();
+        ++header_->schema_generation;
+    }
+
+    uint32_t count = 0;
+    uint64_t truncated = 0;
+    for (const auto &[metric, value] : metric_values) {
+        for_each_value(value, [&](double v) {
+            if (count < capacity_) {
+                values_[count++] = v;
+            } else {
+                ++truncated;
+            }
+        });
+    }
+    header_->count = count;
+    header_->realtime_ns = tick.realtime_ns;
+    header_->monotonic_ns = tick.monotonic_ns;
+
+    header_->sequence.store(sequence + 2, std::memory_order_release);
+
+    if (truncated > 0) {
+        truncated_series_ += truncated;
+    }
+}
+
+void ShmOutput::write_event(const Timestamp &tick, const IMetric* metric,
+                            const MetricValue &value) {
+    if (!header_ || !has_schema_) {
+        return;
+    }
+
+    // Ряды метрики в текущей схеме: [offset, offset + entry->count)
+    const std::string name = metric->name();
+    const StreamSchema::Entry* entry = nullptr;
+    uint32_t offset = 0;
+    for (const auto &candidate : schema_.entries) {
+        if (candidate.name == name) {
+            entry = &candidate;
+            break;
+        }
+        offset += candidate.count;
+    }
+    if (!entry || offset >= capacity_) {
+        return;
+    }
+    bool is_map = std::holds_alternative<std::map<std::string, double>>(value);
+    if (is_map != (entry->kind == StreamSchema::Kind::Map)) {
+        return;
+    }
+
+    // Форма значения, отличная от схемы, не публикуется: иначе читатели
+    // увидели бы чужие ряды под этими именами
+    std::vector<std::pair<uint32_t, double>> updates;
+    if (is_map) {
+        for (const auto &[key, v] : std::get<std::map<std::string, double>>(value)) {
+            auto it = std::lower_bound(entry->keys.begin(), entry->keys.end(), key);
+            if (it != entry->keys.end() && *it == key) {
+                updates.emplace_back(offset + static_cast<uint32_t>(it - entry->keys.begin()), v);
+            }
+        }
+    } else {
+        uint32_t index = offset;
+        for_each_value(value, [&](double v) { updates.emplace_back(index++, v); });
+        if (index - offset != entry->count) {
+            return;
+        }
+    }
+
+    uint64_t sequence = header_->sequence.load(std::memory_order_relaxed);
+    header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (const auto &[index, v] : updates) {
+        if (index < capacity_) {
+            values_[index] = v;
+        }
+    }
+    header_->realtime_ns = tick.realtime_ns;
+    header_->monotonic_ns = tick.monotonic_ns;
+
+    header_->sequence.store(sequence + 2, std::memory_order_release);
+}
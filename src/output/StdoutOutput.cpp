@@ -0,0 +1,169 @@
+#include "output/StdoutOutput.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+// Имя ряда Prometheus: [a-zA-Z0-9_], остальное заменяется на '_'
+void append_name(std::string &out, const std::string &name) {
+    out += "status_monitor_";
+    for (char c : name) {
+        bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                       (c >= '0' && c <= '9') || c == '_';
+        out += allowed ? c : '_';
+    }
+}
+
+// Имя ряда с метками: label="value" (если label задан) и event="true"
+// для внеочередных значений
+void append_series(std::string &out, const std::string &name, const char* label,
+                   const std::string &value, bool event) {
+    out += name;
+    if (!label && !event) {
+        return;
+    }
+    out += '{';
+    if (label) {
+        out += label;
+        out += "=\"";
+        for (char c : value) {
+            if (c == '\\' || c == '"') {
+                out += '\\';
+                out += c;
+            } else if (c == '\n') {
+                out += "\\n";
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+        if (event) {
+            out += ',';
+        }
+    }
+    if (event) {
+        out += "event=\"true\"";
+    }
+    out += '}';
+}
+
+// Значение и метка времени; NaN и бесконечности пишутся так, как их ждёт Prometheus
+void append_sample(std::string &out, double value, int64_t timestamp_ms) {
+    char buffer[64];
+    int length = 0;
+    if (std::isnan(value)) {
+        length = std::snprintf(buffer, sizeof(buffer), " NaN %lld\n",
+                               static_cast<long long>(timestamp_ms));
+    } else if (std::isinf(value)) {
+        length = std::snprintf(buffer, sizeof(buffer), " %cInf %lld\n", value > 0 ? '+' : '-',
+                               static_cast<long long>(timestamp_ms));
+    } else {
+        length = std::snprintf(buffer, sizeof(buffer), " %.17g %lld\n", value,
+                               static_cast<long long>(timestamp_ms));
+    }
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+} // namespace
+
+StdoutOutput::StdoutOutput(const json &config) : StdoutOutput(config, std::cout) {}
+
+StdoutOutput::StdoutOutput(const json &config, std::ostream &out) : out_(out) {
+    std::string format = config.value("format", "jsonl");
+    if (format == "jsonl") {
+        format_ = Format::Jsonl;
+    } else if (format == "prometheus") {
+        format_ = Format::Prometheus;
+    } else {
+        throw std::invalid_argument("Stdout output 'format' must be 'jsonl' or 'prometheus'");
+    }
+}
+
+bool StdoutOutput::is_valid() const { return true; }
+
+void StdoutOutput::write_prometheus(int64_t timestamp_ms, const IMetric* metric,
+                                    const MetricValue &value, bool event) {
+    // Метрика без значений (например, до базового замера) не выводится
+    if ((std::holds_alternative<std::vector<int>>(value) &&
+         std::get<std::vector<int>>(value).empty()) ||
+        (std::holds_alternative<std::vector<double>>(value) &&
+         std::get<std::vector<double>>(value).empty()) ||
+        (std::holds_alternative<std::map<std::string, double>>(value) &&
+         std::get<std::map<std::string, double>>(value).empty())) {
+        return;
+    }
+
+    std::string name;
+    append_name(name, metric->name());
+    // Поток stdout - одна длинная экспозиция: тип семейства объявляется
+    // один раз, перед его первым рядом
+    if (typed_.insert(name).second) {
+        line_ += "# TYPE ";
+        line_ += name;
+        line_ += " gauge\n";
+    }
+
+    auto indexed = [&](size_t index, double v) {
+        append_series(line_, name, "index", std::to_string(index), event);
+        append_sample(line_, v, timestamp_ms);
+    };
+
+    if (std::holds_alternative<int>(value)) {
+        append_series(line_, name, nullptr, {}, event);
+        append_sample(line_, std::get<int>(value), timestamp_ms);
+    } else if (std::holds_alternative<double>(value)) {
+        append_series(line_, name, nullptr, {}, event);
+        append_sample(line_, std::get<double>(value), timestamp_ms);
+    } else if (std::holds_alternative<std::vector<int>>(value)) {
+        const auto &values = std::get<std::vector<int>>(value);
+        for (size_t i = 0; i < values.size(); ++i) {
+            indexed(i, values[i]);
+        }
+    } else if (std::holds_alternative<std::vector<double>>(value)) {
+        const auto &values = std::get<std::vector<double>>(value);
+        for (size_t i = 0; i < values.size(); ++i) {
+            indexed(i, values[i]);
+        }
+    } else if (std::holds_alternative<std::map<std::string, double>>(value)) {
+        for (const auto &[key, v] : std::get<std::map<std::string, double>>(value)) {
+            append_series(line_, name, "key", key, event);
+            append_sample(line_, v, timestamp_ms);
+        }
+    }
+}
+
+void StdoutOutput::write(const Timestamp &tick,
+                         const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    write_lines(tick, metric_values, false);
+}
+
+void StdoutOutput::write_event(const Timestamp &tick, const IMetric* metric,
+                               const MetricValue &value) {
+    write_lines(tick, {{metric, value}}, true);
+}
+
+void StdoutOutput::write_lines(
+    const Timestamp &tick,
+    const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values, bool event) {
+    if (format_ == Format::Jsonl) {
+        writer_.clear();
+        JsonlOutput::serialize(writer_, tick.realtime_ms(), metric_values, keys_, event);
+        writer_.raw('\n');
+        out_.write(writer_.data(), static_cast<std::streamsize>(writer_.size()));
+    } else {
+        line_.clear();
+        for (const auto &[metric, value] : metric_values) {
+            if (metric->is_valid()) {
+                write_prometheus(tick.realtime_ms(), metric, value, event);
+            }
+        }
+        out_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    }
+    out_.flush();
+}
+
+void StdoutOutput::finish() {
+    out_.flush();
+}
@@ -0,0 +1,250 @@
+#include "output/StreamOutput.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <limits.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+constexpr auto kInitialBackoff = std::chrono::milliseconds(100);
+constexpr auto kMaxBackoff = std::chrono::seconds(5);
+
+FrameType frame_type(const std::string &frame) {
+    return static_cast<FrameType>(frame[4]);
+}
+
+} // namespace
+
+StreamOutput::StreamOutput(const json &config) : backoff_(kInitialBackoff) {
+    if (!config.contains("address") || !config["address"].is_string()) {
+        return;
+    }
+    endpoint_ = Endpoint::parse(config["address"].get<std::string>());
+
+    if (config.contains("node") && config["node"].is_string()) {
+        node_ = config["node"].get<std::string>();
+    } else {
+        char hostname[HOST_NAME_MAX + 1] = {};
+        if (gethostname(hostname, sizeof(hostname) - 1) == 0) {
+            node_ = hostname;
+        }
+    }
+    if (node_.empty()) {
+        throw std::invalid_argument("Stream output requires a non-empty 'node' name");
+    }
+
+    if (config.contains("max_buffer")) {
+        if (!config["max_buffer"].is_number_integer() ||
+            config["max_buffer"].get<long long>() <= 0) {
+            throw std::invalid_argument("Stream output 'max_buffer' must be a positive integer");
+        }
+        max_buffer_ = config["max_buffer"].get<size_t>();
+    }
+
+    valid_ = true;
+    try_connect();
+}
+
+StreamOutput::~StreamOutput() {
+    disconnect();
+}
+
+bool StreamOutput::is_valid() const { return valid_; }
+
+void StreamOutput::try_connect() {
+    fd_ = connect_endpoint(endpoint_);
+    if (fd_ < 0) {
+        next_attempt_ = Clock::now() + backoff_;
+        backoff_ = std::min<Clock::duration>(backoff_ * 2, kMaxBackoff);
+        return;
+    }
+    connecting_ = true;
+}
+
+void StreamOutput::disconnect() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    connecting_ = false;
+    // Частично отправленный кадр будет отправлен заново целиком
+    sent_offset_ = 0;
+    // Приветствие и текущая схема будут отправлены заново при подключении,
+    // значения до последней смены схемы к ней уже не относятся
+    auto last_control = pending_.end();
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+        if (frame_type(*it) != FrameType::Values) {
+            last_control = it;
+        }
+    }
+    if (last_control != pending_.end()) {
+        for (auto it = pending_.begin(); it != std::next(last_control); ++it) {
+            pending_bytes_ -= it->size();
+            if (frame_type(*it) == FrameType::Values) {
+                ++dropped_frames_;
+            }
+        }
+        pending_.erase(pending_.begin(), std::next(last_control));
+    }
+    next_attempt_ = Clock::now() + backoff_;
+    backoff_ = std::min<Clock::duration>(backoff_ * 2, kMaxBackoff);
+}
+
+void StreamOutput::on_connected() {
+    connecting_ = false;
+    backoff_ = kInitialBackoff;
+
+    // Рукопожатие идёт перед накопленными значениями
+    std::string handshake;
+    StreamProtocol::encode_hello(handshake, node_);
+    if (has_schema_) {
+        std::string schema;
+        StreamProtocol::encode_schema(schema, schema_);
+        pending_bytes_ += schema.size();
+        pending_.push_front(std::move(schema));
+    }
+    pending_bytes_ += handshake.size();
+    pending_.push_front(std::move(handshake));
+}
+
+void StreamOutput::drop_stale_values() {
+    // Схема и значения, закодированные по старой схеме, бесполезны для
+    // агрегатора. Частично отправленный кадр и приветствие в начале очереди
+    // остаются: без них поток на этом соединении стал бы нечитаемым.
+    auto keep = pending_.begin();
+    if (sent_offset_ > 0 && keep != pending_.end()) {
+        ++keep;
+    }
+    while (keep != pending_.end() && frame_type(*keep) == FrameType::Hello) {
+        ++keep;
+    }
+    for (auto it = keep; it != pending_.end(); ++it) {
+        pending_bytes_ -= it->size();
+        if (frame_type(*it) == FrameType::Values) {
+            ++dropped_frames_;
+        }
+    }
+    pending_.erase(keep, pending_.end());
+}
+
+void StreamOutput::enqueue(const std::string &frame) {
+    // Освобождаем место, отбрасывая самые старые значения
+    while (pending_bytes_ + frame.size() > max_buffer_) {
+        auto it = pending_.begin();
+        if (sent_offset_ > 0 && it != pending_.end()) {
+            ++it;
+        }
+        while (it != pending_.end() && frame_type(*it) != FrameType::Values) {
+            ++it;
+        }
+        if (it == pending_.end()) {
+            break;
+        }
+        pending_bytes_ -= it->size();
+        pending_.erase(it);
+        ++dropped_frames_;
+    }
+
+    if (pending_bytes_ + frame.size() > max_buffer_ && frame_type(frame) == FrameType::Values) {
+        ++dropped_frames_;
+        return;
+    }
+    pending_bytes_ += frame.size();
+    pending_.push_back(frame);
+}
+
+void StreamOutput::write(const Timestamp &tick, const std::vector<std::pair<const IMetric*, MetricValue>> &metric_values) {
+    if (!valid_) {
+        return;
+    }
+
+    if (!has_schema_ || !schema_.matches(metric_values)) {
+        schema_ = StreamSchema::from(metric_values);
+        has_schema_ = true;
+        drop_stale_values();
+        // Без подключения схема уйдёт в составе рукопожатия
+        if (connected()) {
+            frame_.clear();
+            StreamProtocol::encode_schema(frame_, schema_);
+            enqueue(frame_);
+        }
+    }
+
+    frame_.clear();
+    StreamProtocol::encode_values(frame_, static_cast<uint64_t>(tick.realtime_ms()), metric_values);
+    enqueue(frame_);
+
+    flush();
+}
+
+void StreamOutput::finish() {
+    auto deadline = Clock::now() + kFinishTimeout;
+    while (!flush() && Clock::now() < deadline) {
+        if (fd_ >= 0) {
+            // Ждём завершения подключения или места в буфере сокета
+            pollfd pfd{fd_, POLLOUT, 0};
+            poll(&pfd, 1, 50);
+        } else {
+            // Ждём следующей попытки подключения
+            std::this_thread::sleep_for(std::min<Clock::duration>(
+                std::chrono::milliseconds(50), std::max<Clock::duration>(
+                    next_attempt_ - Clock::now(), Clock::duration::zero())));
+        }
+    }
+}
+
+bool StreamOutput::flush() {
+    if (!valid_) {
+        return false;
+    }
+
+    if (fd_ < 0) {
+        if (Clock::now() < next_attempt_) {
+            return pending_.empty();
+        }
+        try_connect();
+        if (fd_ < 0) {
+            return pending_.empty();
+        }
+    }
+
+    if (connecting_) {
+        int state = check_connected(fd_);
+        if (state < 0) {
+            disconnect();
+            return pending_.empty();
+        }
+        if (state == 0) {
+            return pending_.empty();
+        }
+        on_connected();
+    }
+
+    while (!pending_.empty()) {
+        const std::string &frame = pending_.front();
+        ssize_t sent = send(fd_, frame.data() + sent_offset_, frame.size() - sent_offset_,
+                            MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                disconnect();
+            }
+            return false;
+        }
+
+        sent_offset_ += static_cast<size_t>(sent);
+        if (sent_offset_ == frame.size()) {
+            pending_bytes_ -= frame.size();
+            pending_.pop_front();
+            sent_offset_ = 0;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "metrics/IMetric.hpp"
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Метрика-заглушка для тестов выходов, ядра и сетевого режима: значения
+// задаёт сам тест, метрика хранит только имя и единицу своих рядов.
+class FakeMetric : public IMetric {
+public:
+    explicit FakeMetric(std::string name = "fake", const char* unit = "")
+        : name_(std::move(name)), unit_(unit) {}
+
+    MetricValue collect() const override { return MetricValue{}; }
+    bool is_valid() const override { return true; }
+    std::string name() const override { return name_; }
+    const char* unit(std::string_view) const override { return unit_; }
+
+private:
+    std::string name_;
+    const char* unit_;
+};
@@ -0,0 +1,106 @@
+#include "core/CommandLine.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(CommandLineTest, ConfigOnly) {
+    const char* argv[] = {"status_monitor", "config.json"};
+    CommandLine options = CommandLine::parse(2, argv);
+    EXPECT_EQ(options.config_path, "config.json");
+    EXPECT_FALSE(options.verbose);
+    EXPECT_FALSE(options.startup_profile);
+}
+
+TEST(CommandLineTest, Flags) {
+    const char* argv[] = {"status_monitor", "--startup-profile", "config.json", "-v"};
+    CommandLine options = CommandLine::parse(4, argv);
+    EXPECT_EQ(options.config_path, "config.json");
+    EXPECT_TRUE(options.verbose);
+    EXPECT_TRUE(options.startup_profile);
+}
+
+TEST(CommandLineTest, Errors) {
+    const char* missing[] = {"status_monitor", "--verbose"};
+    EXPECT_THROW(CommandLine::parse(2, missing), std::invalid_argument);
+
+    const char* unknown[] = {"status_monitor", "--bogus", "config.json"};
+    EXPECT_THROW(CommandLine::parse(3, unknown), std::invalid_argument);
+
+    const char* extra[] = {"status_monitor", "a.json", "b.json"};
+    EXPECT_THROW(CommandLine::parse(3, extra), std::invalid_argument);
+}
+
+TEST(CommandLineTest, Once) {
+    const char* argv[] = {"status_monitor", "--once", "--format", "jsonl", "config.json"};
+    CommandLine options = CommandLine::parse(5, argv);
+    EXPECT_TRUE(options.bounded());
+    EXPECT_EQ(options.count, 1);
+    EXPECT_EQ(options.window_ms, CommandLine::kOnceWindowMs);
+    EXPECT_EQ(options.format, "jsonl");
+
+    // Явное окно не заменяется значением по умолчанию
+    const char* window[] = {"status_monitor", "--window=20ms", "--once", "config.json"};
+    EXPECT_EQ(CommandLine::parse(4, window).window_ms, 20);
+}
+
+TEST(CommandLineTest, CountAndDuration) {
+    const char* argv[] = {"status_monitor", "--count=3", "--duration", "1.5m",
+                          "--format=prometheus", "config.json"};
+    CommandLine options = CommandLine::parse(6, argv);
+    EXPECT_EQ(options.count, 3);
+    EXPECT_EQ(options.duration_ms, 90000);
+    EXPECT_EQ(options.window_ms, 0);
+    EXPECT_EQ(options.format, "prometheus");
+
+    const char* unbounded[] = {"status_monitor", "config.json"};
+    EXPECT_FALSE(CommandLine::parse(2, unbounded).bounded());
+}
+
+TEST(CommandLineTest, ParseDuration) {
+    EXPECT_EQ(CommandLine::parse_duration_ms("250ms"), 250);
+    EXPECT_EQ(CommandLine::parse_duration_ms("10"), 10000);
+    EXPECT_EQ(CommandLine::parse_duration_ms("0.5s"), 500);
+    EXPECT_EQ(CommandLine::parse_duration_ms("2h"), 7200000);
+
+    EXPECT_THROW(CommandLine::parse_duration_ms(""), std::invalid_argument);
+    EXPECT_THROW(CommandLine::parse_duration_ms("5d"), std::invalid_argument);
+    EXPECT_THROW(CommandLine::parse_duration_ms("0"), std::invalid_argument);
+    EXPECT_THROW(CommandLine::parse_duration_ms("-1s"), std::invalid_argument);
+}
+
+TEST(CommandLineTest, BoundedErrors) {
+    const char* both[] = {"status_monitor", "--once", "--count", "2", "config.json"};
+    EXPECT_THROW(CommandLine::parse(5, both), std::invalid_argument);
+
+    const char* zero[] = {"status_monitor", "--count", "0", "config.json"};
+    EXPECT_THROW(CommandLine::parse(4, zero), std::invalid_argument);
+
+    const char* no_value[] = {"status_monitor", "config.json", "--count"};
+    EXPECT_THROW(CommandLine::parse(3, no_value), std::invalid_argument);
+
+    const char* format[] = {"status_monitor", "--format", "csv", "config.json"};
+    EXPECT_THROW(CommandLine::parse(4, format), std::invalid_argument);
+}
+
+TEST(CommandLineTest, WindowOnlyForBuiltInRateMetrics) {
+    const char* argv[] = {"status_monitor", "--window=20ms", "config.json"};
+    CommandLine options = CommandLine::parse(3, argv);
+
+    nlohmann::json config = {{"metrics",
+                              {{{"type", "cpu"}, {"library", "./cpu_metric.so"}},
+                               {{"type", "net"}},
+                               {{"type", "disk"}, {"config", {{"window_ms", 500}}}},
+                               {{"type", "memory"}, {"library", "./memory_metric.so"}},
+                               {{"type", "gpu"}, {"library", "./gpu_metric.so"}},
+                               {{"type", "cpu"}, {"library", "/opt/vendor/libcpu.so"}}}}};
+    options.apply_window(config);
+
+    const auto &metrics = config["metrics"];
+    EXPECT_EQ(metrics[0]["config"]["window_ms"], 20);
+    EXPECT_EQ(metrics[1]["config"]["window_ms"], 20);
+    // Заданное в конфигурации окно не перезаписывается
+    EXPECT_EQ(metrics[2]["config"]["window_ms"], 500);
+    // Остальные метрики и сторонние плагины конфигурацию не получают
+    EXPECT_FALSE(metrics[3].contains("config"));
+    EXPECT_FALSE(metrics[4].contains("config"));
+    EXPECT_FALSE(metrics[5].contains("config"));
+}
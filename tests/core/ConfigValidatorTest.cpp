@@ -0,0 +1,103 @@
+#include "core/ConfigValidator.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+json valid_config() {
+    return json::parse(R"({
+        "settings": {"period": 5},
+        "metrics": [
+            {"type": "cpu", "library": "./cpu_metric.so", "config": {"cpu_ids": [0]}}
+        ],
+        "outputs": [{"type": "console"}, {"type": "jsonl", "path": "out.jsonl"}]
+    })");
+}
+
+bool has_error(const std::vector<std::string> &errors, const std::string &prefix) {
+    for (const auto &error : errors) {
+        if (error.compare(0, prefix.size(), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(ConfigValidatorTest, ValidConfig) {
+    EXPECT_TRUE(validate_config(valid_config()).empty());
+}
+
+TEST(ConfigValidatorTest, NotAnObject) {
+    auto errors = validate_config(json::array());
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_TRUE(has_error(errors, "config:"));
+}
+
+TEST(ConfigValidatorTest, ReportsAllErrorsAtOnce) {
+    json config = valid_config();
+    config["settings"]["period"] = 0;
+    config["settings"]["verbose"] = "yes";
+    config["metrics"].push_back({{"library", "./memory_metric.so"}, {"config", 1}});
+    config["metrics"].push_back({{"type", "no_such_builtin"}});
+    config["outputs"].push_back({{"type", "stream"}});
+    config["outputs"].push_back({{"type", "printer"}});
+
+    auto errors = validate_config(config);
+    EXPECT_EQ(errors.size(), 7u);
+    EXPECT_TRUE(has_error(errors, "settings.period:"));
+    EXPECT_TRUE(has_error(errors, "settings.verbose:"));
+    EXPECT_TRUE(has_error(errors, "metrics[1].type:"));
+    EXPECT_TRUE(has_error(errors, "metrics[1].config:"));
+    EXPECT_TRUE(has_error(errors, "metrics[2].library:"));
+    EXPECT_TRUE(has_error(errors, "outputs[2].address:"));
+    EXPECT_TRUE(has_error(errors, "outputs[3].type:"));
+}
+
+TEST(ConfigValidatorTest, MissingSections) {
+    auto errors = validate_config(json::object());
+    EXPECT_EQ(errors.size(), 3u);
+    EXPECT_TRUE(has_error(errors, "settings:"));
+    EXPECT_TRUE(has_error(errors, "metrics:"));
+    EXPECT_TRUE(has_error(errors, "outputs:"));
+}
+
+TEST(ConfigValidatorTest, FileOutputAcceptsFileOrPath) {
+    json config = valid_config();
+    config["outputs"] = {{{"type", "file"}, {"file", "a.log"}}, {{"type", "file"}, {"path", "b.log"}}};
+    EXPECT_TRUE(validate_config(config).empty());
+
+    config["outputs"] = {{{"type", "file"}}};
+    EXPECT_TRUE(has_error(validate_config(config), "outputs[0].file:"));
+}
+
+TEST(ConfigValidatorTest, AggregatorRole) {
+    json config = {{"settings", {{"period", 5}, {"role", "aggregator"}}},
+                   {"outputs", {{{"type", "console"}}}}};
+    auto errors = validate_config(config);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_TRUE(has_error(errors, "settings.listen:"));
+
+    config["settings"]["listen"] = "tcp://0.0.0.0:9100";
+    EXPECT_TRUE(validate_config(config).empty());
+
+    config["settings"]["role"] = "observer";
+    EXPECT_TRUE(has_error(validate_config(config), "settings.role:"));
+}
+
+TEST(ConfigValidatorTest, OutputsOptionalWithFormat) {
+    json config = valid_config();
+    config.erase("outputs");
+    EXPECT_TRUE(has_error(validate_config(config), "outputs:"));
+    EXPECT_TRUE(validate_config(config, false).empty());
+
+    config["outputs"] = json::array();
+    EXPECT_TRUE(validate_config(config, false).empty());
+
+    // Заданные выходы проверяются как обычно
+    config["outputs"] = {{{"type", "jsonl"}}};
+    EXPECT_TRUE(has_error(validate_config(config, false), "outputs[0].path:"));
+
+    config["outputs"] = "console";
+    EXPECT_TRUE(has_error(validate_config(config, false), "outputs:"));
+}
@@ -0,0 +1,48 @@
+#include "core/EventQueue.hpp"
+#include "FakeMetric.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(EventQueueTest, TimeoutWithoutEvents) {
+    EventQueue queue;
+    std::vector<EventQueue::Event> events;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+    EXPECT_FALSE(queue.wait_until(deadline, events));
+    EXPECT_TRUE(events.empty());
+}
+
+TEST(EventQueueTest, WakesOnEventFromAnotherThread) {
+    EventQueue queue;
+    FakeMetric metric;
+    auto callback = queue.callback();
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        callback(&metric, 42.0);
+    });
+
+    std::vector<EventQueue::Event> events;
+    EXPECT_TRUE(queue.wait_until(start + std::chrono::seconds(5), events));
+    producer.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].metric, &metric);
+    EXPECT_EQ(std::get<double>(events[0].value), 42.0);
+    EXPECT_GT(events[0].tick.realtime_ns, 0);
+}
+
+TEST(EventQueueTest, DropsOldestWhenFull) {
+    EventQueue queue(2);
+    FakeMetric metric;
+    queue.push(&metric, 1);
+    queue.push(&metric, 2);
+    queue.push(&metric, 3);
+
+    std::vector<EventQueue::Event> events;
+    ASSERT_TRUE(queue.wait_until(std::chrono::steady_clock::now(), events));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(std::get<int>(events[0].value), 2);
+    EXPECT_EQ(queue.dropped(), 1u);
+}
@@ -0,0 +1,131 @@
+#include "core/OverheadGovernor.hpp"
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+constexpr int64_t kSecond = 1000000000;
+
+// Процент одного ядра за секунду реального времени
+int64_t cpu_ns(double percent) {
+    return static_cast<int64_t>(percent / 100.0 * kSecond);
+}
+
+} // namespace
+
+TEST(OverheadGovernorTest, DisabledByDefault) {
+    OverheadGovernor governor;
+    EXPECT_FALSE(governor.enabled());
+    EXPECT_FALSE(governor.is_valid());
+    EXPECT_EQ(governor.stretch(), 1);
+    EXPECT_FALSE(governor.skip(-1));
+}
+
+TEST(OverheadGovernorTest, InvalidConfig) {
+    EXPECT_THROW(OverheadGovernor(json::object()), std::invalid_argument);
+    EXPECT_THROW(OverheadGovernor(json{{"budget", 0}}), std::invalid_argument);
+    EXPECT_THROW(OverheadGovernor(json{{"budget", 0.5}, {"max_stretch", 0}}), std::invalid_argument);
+    EXPECT_THROW(OverheadGovernor(json{{"budget", 0.5}, {"pin_cpu", -1}}), std::invalid_argument);
+}
+
+TEST(OverheadGovernorTest, StretchesThenSkipsWhenOverBudget) {
+    OverheadGovernor governor(json{{"budget", 0.5}, {"max_stretch", 4}});
+    EXPECT_EQ(governor.name(), "governor");
+
+    governor.update(cpu_ns(0.1), kSecond);
+    EXPECT_EQ(governor.level(), 0);
+    EXPECT_EQ(governor.stretch(), 1);
+
+    governor.update(cpu_ns(2.0), kSecond);
+    EXPECT_EQ(governor.stretch(), 2);
+    EXPECT_FALSE(governor.skip(-1));
+
+    governor.update(cpu_ns(2.0), kSecond);
+    EXPECT_EQ(governor.stretch(), 4);
+    EXPECT_FALSE(governor.skip(-1));
+
+    governor.update(cpu_ns(2.0), kSecond);
+    EXPECT_EQ(governor.stretch(), 4);
+    EXPECT_TRUE(governor.skip(-1));
+    EXPECT_FALSE(governor.skip(0));
+
+    // Дальше ступеней нет
+    governor.update(cpu_ns(2.0), kSecond);
+    EXPECT_EQ(governor.level(), 3);
+}
+
+TEST(OverheadGovernorTest, RestoresWithHeadroom) {
+    OverheadGovernor governor(json{{"budget", 1.0}});
+    governor.update(cpu_ns(5.0), kSecond);
+    ASSERT_EQ(governor.level(), 1);
+
+    // Близко к бюджету - не откатываемся
+    for (int i = 0; i < 5; ++i) {
+        governor.update(cpu_ns(0.8), kSecond);
+    }
+    EXPECT_EQ(governor.level(), 1);
+
+    // С запасом - откат после нескольких спокойных тиков
+    governor.update(cpu_ns(0.1), kSecond);
+    governor.update(cpu_ns(0.1), kSecond);
+    EXPECT_EQ(governor.level(), 1);
+    governor.update(cpu_ns(0.1), kSecond);
+    EXPECT_EQ(governor.level(), 0);
+    EXPECT_EQ(governor.stretch(), 1);
+}
+
+TEST(OverheadGovernorTest, CollectReportsDecisions) {
+    OverheadGovernor governor(json{{"budget", 0.5}});
+    governor.update(cpu_ns(1.0), kSecond);
+
+    auto state = std::get<std::map<std::string, double>>(governor.collect());
+    EXPECT_DOUBLE_EQ(state["usage_percent"], 1.0);
+    EXPECT_DOUBLE_EQ(state["budget_percent"], 0.5);
+    EXPECT_DOUBLE_EQ(state["level"], 1.0);
+    EXPECT_DOUBLE_EQ(state["stretch"], 2.0);
+    EXPECT_DOUBLE_EQ(state["skip_low_priority"], 0.0);
+}
+
+TEST(OverheadGovernorTest, MeasuresOwnCpuTime) {
+    OverheadGovernor governor(json{{"budget", 100.0}});
+    governor.update();
+
+    // Нагружаем процессор, чтобы потребление было заметным
+    volatile double sink = 0.0;
+    for (int i = 0; i < 5000000; ++i) {
+        sink = sink + i * 0.5;
+    }
+    governor.update();
+
+    EXPECT_GT(governor.usage_percent(), 0.0);
+}
+
+TEST(OverheadGovernorTest, PinIsInheritedByLaterThreads) {
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+        ++cpu;
+    }
+
+    // Привязка в отдельном потоке, чтобы не ограничивать остальные тесты
+    int worker_cpus = -1;
+    bool worker_pinned = false;
+    std::thread collector([&] {
+        OverheadGovernor governor(json{{"budget", 0.5}, {"pin_cpu", cpu}});
+        governor.pin_current_thread();
+        std::thread worker([&] {
+            cpu_set_t set;
+            sched_getaffinity(0, sizeof(set), &set);
+            worker_cpus = CPU_COUNT(&set);
+            worker_pinned = CPU_ISSET(cpu, &set);
+        });
+        worker.join();
+    });
+    collector.join();
+
+    EXPECT_EQ(worker_cpus, 1);
+    EXPECT_TRUE(worker_pinned);
+}
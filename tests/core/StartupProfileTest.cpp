@@ -0,0 +1,35 @@
+#include "core/StartupProfile.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(StartupProfileTest, DisabledReportsNothing) {
+    StartupProfile profile(false);
+    profile.mark("config read");
+    std::ostringstream out;
+    profile.report(out);
+    EXPECT_TRUE(out.str().empty());
+}
+
+TEST(StartupProfileTest, PhasesInOrderWithNested) {
+    StartupProfile profile(true);
+    profile.mark("config read");
+    profile.add("metric cpu", std::chrono::milliseconds(3));
+    profile.mark("metric loading");
+
+    std::ostringstream out;
+    profile.report(out);
+    std::string report = out.str();
+
+    size_t exec = report.find("exec to main");
+    size_t config = report.find("config read");
+    size_t loading = report.find("metric loading");
+    size_t nested = report.find("    metric cpu");
+    size_t total = report.find("total to first tick");
+    ASSERT_NE(exec, std::string::npos);
+    ASSERT_NE(nested, std::string::npos);
+    EXPECT_LT(exec, config);
+    EXPECT_LT(config, loading);
+    EXPECT_LT(loading, nested);
+    EXPECT_LT(nested, total);
+    EXPECT_NE(report.find("3.00"), std::string::npos);
+}
@@ -0,0 +1,56 @@
+#include "core/Timestamp.hpp"
+#include "core/TimestampFormatter.hpp"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+
+class TimestampFormatterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char* tz = std::getenv("TZ");
+        saved_tz_ = tz ? tz : "";
+        had_tz_ = tz != nullptr;
+        setenv("TZ", "UTC", 1);
+        tzset();
+    }
+
+    void TearDown() override {
+        if (had_tz_) {
+            setenv("TZ", saved_tz_.c_str(), 1);
+        } else {
+            unsetenv("TZ");
+        }
+        tzset();
+    }
+
+private:
+    std::string saved_tz_;
+    bool had_tz_ = false;
+};
+
+TEST_F(TimestampFormatterTest, FormatsIsoWithMilliseconds) {
+    TimestampFormatter formatter;
+    EXPECT_EQ(formatter.format(1700000000123456789), "2023-11-14T22:13:20.123+00:00");
+}
+
+TEST_F(TimestampFormatterTest, SameSecondReusesPrefix) {
+    TimestampFormatter formatter;
+    EXPECT_EQ(formatter.format(1700000000000000000), "2023-11-14T22:13:20.000+00:00");
+    EXPECT_EQ(formatter.format(1700000000999000000), "2023-11-14T22:13:20.999+00:00");
+    EXPECT_EQ(formatter.format(1700000001005000000), "2023-11-14T22:13:21.005+00:00");
+}
+
+TEST_F(TimestampFormatterTest, TimezoneOffset) {
+    setenv("TZ", "UTC-3", 1);
+    tzset();
+    TimestampFormatter formatter;
+    EXPECT_EQ(formatter.format(1700000000123000000), "2023-11-15T01:13:20.123+03:00");
+}
+
+TEST(TimestampTest, NowIsConsistent) {
+    Timestamp first = Timestamp::now();
+    Timestamp second = Timestamp::now();
+    EXPECT_GT(first.realtime_ns, 0);
+    EXPECT_GE(second.monotonic_ns, first.monotonic_ns);
+    EXPECT_EQ(first.realtime_ms(), first.realtime_ns / 1000000);
+}
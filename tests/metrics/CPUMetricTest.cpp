@@ -1,6 +1,8 @@
 #include "metrics/CPUMetric.hpp"
 #include <gtest/gtest.h>
 #include <stdexcept>
+#include <chrono>
+#include <thread>
 #include <variant>
 
 TEST(CPUMetricTest, ValidConfig) {
@@ -98,3 +100,81 @@ TEST(CPUMetricTest, CollectWithInvalidCPU) {
         EXPECT_EQ(usage[0], 0.0); // Ожидаем 0 для несуществующего CPU
     }
 }
+
+TEST(CPUMetricTest, InvalidConfigSubsample) {
+    json config = {{"cpu_ids", {0}}, {"subsample_ms", 0}};
+    EXPECT_THROW(CPUMetric metric(config), std::invalid_argument);
+}
+
+TEST(CPUMetricTest, CollectSubsampled) {
+    json config = {{"cpu_ids", {0, 1}}, {"subsample_ms", 20}};
+    CPUMetric metric(config);
+    ASSERT_TRUE(metric.is_valid());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto result = metric.collect();
+
+    bool is_map = std::holds_alternative<std::map<std::string, double>>(result);
+    ASSERT_TRUE(is_map);
+
+    auto stats = std::get<std::map<std::string, double>>(result);
+    ASSERT_TRUE(stats.count("cpu0.mean"));
+    EXPECT_GE(stats["cpu0.min"], 0.0);
+    EXPECT_LE(stats["cpu0.min"], stats["cpu0.mean"]);
+    EXPECT_LE(stats["cpu0.mean"], stats["cpu0.max"]);
+    EXPECT_LE(stats["cpu0.p95"], stats["cpu0.max"]);
+    EXPECT_LE(stats["cpu0.max"], 100.0);
+}
+
+TEST(CPUMetricTest, CollectSubsampledResetsPerPeriod) {
+    json config = {{"cpu_ids", {999999}}, {"subsample_ms", 10}};
+    CPUMetric metric(config);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto stats = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_TRUE(stats.empty());  // Несуществующий CPU не попадает в отчёт
+}
+
+TEST(CPUMetricTest, InvalidConfigWindow) {
+    EXPECT_THROW(CPUMetric(json{{"cpu_ids", {0}}, {"window_ms", 0}}), std::invalid_argument);
+    EXPECT_THROW(CPUMetric(json{{"cpu_ids", {0}}, {"window_ms", "100"}}), std::invalid_argument);
+}
+
+TEST(CPUMetricTest, DefaultFirstCollectIsFast) {
+    // Без window_ms первый сбор не должен ждать секунду после загрузки
+    CPUMetric metric(json{{"cpu_ids", {0}}});
+    auto start = std::chrono::steady_clock::now();
+    auto usage = std::get<std::vector<double>>(metric.collect());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(usage.size(), 1u);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST(CPUMetricTest, CollectWithShortWindow) {
+    // Первый замер ждёт только остаток окна от базового, а не секунду
+    CPUMetric metric(json{{"cpu_ids", {0}}, {"window_ms", 50}});
+    auto start = std::chrono::steady_clock::now();
+    auto usage = std::get<std::vector<double>>(metric.collect());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(usage.size(), 1u);
+    EXPECT_GE(usage[0], 0.0);
+    EXPECT_LE(usage[0], 100.0);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST(CPUMetricTest, FirstSubsampledCollectHasSeries) {
+    // Сразу после загрузки поток ещё не сделал замер: сбор ждёт его
+    CPUMetric metric(json{{"cpu_ids", {0}}, {"subsample_ms", 50}});
+    auto stats = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_TRUE(stats.count("cpu0.mean"));
+}
+
+TEST(CPUMetricTest, SubsampledKeepsSeriesOrderByIndex) {
+    // Ядра ищутся по номеру: несуществующий номер впереди не сдвигает остальные
+    CPUMetric metric(json{{"cpu_ids", {999999, 0}}, {"subsample_ms", 20}});
+    auto stats = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_TRUE(stats.count("cpu0.mean"));
+    EXPECT_FALSE(stats.count("cpu999999.mean"));
+}
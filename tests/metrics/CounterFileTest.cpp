@@ -0,0 +1,65 @@
+#include "metrics/CounterFile.hpp"
+#include "TempDir.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+using json = nlohmann::json;
+
+class CounterFileTest : public ::testing::Test {
+protected:
+    TempDir dir{"counter_file_test"};
+    std::string root = dir.path();
+};
+
+TEST_F(CounterFileTest, MissingFile) {
+    CounterFile file(json{{"proc_root", root}, {"window_ms", 10}}, "Test", "counters",
+                     "Test counters", 1);
+    EXPECT_FALSE(file.is_open());
+    EXPECT_FALSE(file.needs_baseline());
+    EXPECT_TRUE(file.read().empty());
+}
+
+TEST_F(CounterFileTest, InvalidConfig) {
+    dir.write("counters", "a 1\n");
+    EXPECT_THROW(CounterFile(json{{"proc_root", 1}}, "Test", "counters", "Test counters", 1),
+                 std::invalid_argument);
+    EXPECT_THROW(CounterFile(json{{"proc_root", root}, {"window_ms", -1}}, "Test", "counters",
+                             "Test counters", 1),
+                 std::invalid_argument);
+    EXPECT_THROW(CounterFile(json{{"proc_root", root}, {"window_ms", "1"}}, "Test", "counters",
+                             "Test counters", 1),
+                 std::invalid_argument);
+}
+
+TEST_F(CounterFileTest, ReadBeginsRoundAfterWindow) {
+    dir.write("counters", "a 1\n");
+    CounterFile file(json{{"proc_root", root}, {"window_ms", 50}}, "Test", "counters",
+                     "Test counters", 1);
+    EXPECT_TRUE(file.needs_baseline());
+
+    uint64_t value = 1;
+    EXPECT_EQ(file.read(), "a 1\n");
+    EXPECT_EQ(file.rates().update("a", &value), nullptr);
+    file.rates().end();
+
+    // Второй замер ждёт окно и видит данные, записанные во время ожидания
+    dir.write("counters", "a 6\n");
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(file.read(), "a 6\n");
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+    EXPECT_GE(file.rates().interval(), 0.05);
+
+    value = 6;
+    const uint64_t* delta = file.rates().update("a", &value);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(delta[0], 5u);
+}
+
+TEST_F(CounterFileTest, NoWindowNoBaseline) {
+    dir.write("counters", "a 1\n");
+    CounterFile file(json{{"proc_root", root}}, "Test", "counters", "Test counters", 1);
+    EXPECT_TRUE(file.is_open());
+    EXPECT_FALSE(file.needs_baseline());
+}
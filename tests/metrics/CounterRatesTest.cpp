@@ -0,0 +1,154 @@
+#include "metrics/CounterRates.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+namespace {
+
+constexpr int64_t kSecond = 1000000000;
+
+} // namespace
+
+TEST(CounterRatesTest, FirstSampleIsBaseline) {
+    CounterRates rates(2);
+    uint64_t counters[2] = {100, 200};
+
+    rates.begin(kSecond);
+    EXPECT_EQ(rates.update("eth0", counters), nullptr);
+    rates.end();
+    EXPECT_DOUBLE_EQ(rates.interval(), 0.0);
+
+    counters[0] = 150;
+    counters[1] = 260;
+    rates.begin(3 * kSecond);
+    const uint64_t* delta = rates.update("eth0", counters);
+    rates.end();
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(delta[0], 50u);
+    EXPECT_EQ(delta[1], 60u);
+    EXPECT_DOUBLE_EQ(rates.interval(), 2.0);
+}
+
+TEST(CounterRatesTest, Wraparound32Bit) {
+    CounterRates rates(1, nullptr, true);
+    uint64_t counter = UINT32_MAX - 9;
+    rates.begin(kSecond);
+    rates.update("eth0", &counter);
+    rates.end();
+
+    counter = 5;
+    rates.begin(2 * kSecond);
+    const uint64_t* delta = rates.update("eth0", &counter);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(delta[0], 15u);
+}
+
+TEST(CounterRatesTest, ResetStartsNewBaseline) {
+    CounterRates rates(1);
+    uint64_t counter = uint64_t{1} << 40;
+    rates.begin(kSecond);
+    rates.update("veth0", &counter);
+    rates.end();
+
+    // 64-битный счётчик уменьшился - устройство пересоздано
+    counter = 10;
+    rates.begin(2 * kSecond);
+    EXPECT_EQ(rates.update("veth0", &counter), nullptr);
+    rates.end();
+
+    counter = 30;
+    rates.begin(3 * kSecond);
+    const uint64_t* delta = rates.update("veth0", &counter);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(delta[0], 20u);
+}
+
+TEST(CounterRatesTest, RecreatedDeviceBelow4GiB) {
+    // Счётчики /proc 64-битные: уменьшение со значения меньше 2^32 - тоже
+    // пересоздание, а не переполнение с ложным скачком на 4 ГБ
+    CounterRates rates(2);
+    uint64_t counters[2] = {3000000000ull, 500};
+    rates.begin(kSecond);
+    rates.update("veth0", counters);
+    rates.end();
+
+    counters[0] = 1000;
+    counters[1] = 600;
+    rates.begin(2 * kSecond);
+    EXPECT_EQ(rates.update("veth0", counters), nullptr);
+    rates.end();
+
+    counters[0] = 5000;
+    counters[1] = 700;
+    rates.begin(3 * kSecond);
+    const uint64_t* delta = rates.update("veth0", counters);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(delta[0], 4000u);
+    EXPECT_EQ(delta[1], 100u);
+}
+
+TEST(CounterRatesTest, DevicesAppearAndDisappear) {
+    CounterRates rates(1);
+    uint64_t counter = 1;
+
+    rates.begin(kSecond);
+    rates.update("a", &counter);
+    rates.update("b", &counter);
+    rates.update("c", &counter);
+    rates.end();
+    EXPECT_EQ(rates.devices(), 3u);
+
+    // "b" исчез, "d" появился
+    counter = 2;
+    rates.begin(2 * kSecond);
+    EXPECT_NE(rates.update("a", &counter), nullptr);
+    EXPECT_NE(rates.update("c", &counter), nullptr);
+    EXPECT_EQ(rates.update("d", &counter), nullptr);
+    rates.end();
+    EXPECT_EQ(rates.devices(), 3u);
+
+    // Вернувшийся "b" снова начинает с базы
+    counter = 3;
+    rates.begin(3 * kSecond);
+    EXPECT_EQ(rates.update("b", &counter), nullptr);
+    const uint64_t* delta = rates.update("d", &counter);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(delta[0], 1u);
+    rates.end();
+    EXPECT_EQ(rates.devices(), 2u);
+}
+
+TEST(CounterRatesTest, OrderChangeUsesIndex) {
+    CounterRates rates(1);
+    uint64_t counter = 10;
+    rates.begin(kSecond);
+    rates.update("a", &counter);
+    rates.update("b", &counter);
+    rates.end();
+
+    counter = 20;
+    rates.begin(2 * kSecond);
+    const uint64_t* b = rates.update("b", &counter);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b[0], 10u);
+    const uint64_t* a = rates.update("a", &counter);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a[0], 10u);
+}
+
+TEST(CounterRatesTest, FilterCalledOncePerDevice) {
+    int calls = 0;
+    CounterRates rates(1, [&calls](std::string_view name) {
+        ++calls;
+        return name != "lo";
+    });
+    uint64_t counter = 0;
+    for (int round = 1; round <= 3; ++round) {
+        counter += 5;
+        rates.begin(round * kSecond);
+        EXPECT_EQ(rates.update("lo", &counter), nullptr);
+        const uint64_t* delta = rates.update("eth0", &counter);
+        EXPECT_EQ(delta != nullptr, round > 1);
+        rates.end();
+    }
+    EXPECT_EQ(calls, 2);
+}
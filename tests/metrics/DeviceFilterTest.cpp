@@ -0,0 +1,44 @@
+#include "metrics/DeviceFilter.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(DeviceFilterTest, EmptyAcceptsAll) {
+    DeviceFilter filter(nlohmann::json::object());
+    EXPECT_TRUE(filter("eth0"));
+    EXPECT_TRUE(filter(""));
+}
+
+TEST(DeviceFilterTest, IncludeAndExclude) {
+    DeviceFilter filter(nlohmann::json{{"include", {"eth*", "enp?s*", "lo"}},
+                                       {"exclude", {"*.100"}}});
+    EXPECT_TRUE(filter("eth0"));
+    EXPECT_TRUE(filter("enp0s3"));
+    EXPECT_TRUE(filter("lo"));
+    EXPECT_FALSE(filter("lo0"));
+    EXPECT_FALSE(filter("eth0.100"));
+    EXPECT_FALSE(filter("veth12ab"));
+    EXPECT_FALSE(filter("ens3"));
+}
+
+TEST(DeviceFilterTest, MultipleStars) {
+    DeviceFilter filter(nlohmann::json{{"include", {"nvme*n*p*"}}});
+    EXPECT_TRUE(filter("nvme0n1p1"));
+    EXPECT_TRUE(filter("nvme10n2p12"));
+    EXPECT_FALSE(filter("nvme0n1"));
+    EXPECT_FALSE(filter("sda1"));
+
+    DeviceFilter anything(nlohmann::json{{"exclude", {"*"}}});
+    EXPECT_FALSE(anything("sda"));
+}
+
+TEST(DeviceFilterTest, OverlappingParts) {
+    DeviceFilter filter(nlohmann::json{{"include", {"a*aa"}}});
+    EXPECT_TRUE(filter("aaa"));
+    EXPECT_FALSE(filter("aa"));
+}
+
+TEST(DeviceFilterTest, InvalidConfig) {
+    EXPECT_THROW(DeviceFilter(nlohmann::json{{"include", "eth*"}}), std::invalid_argument);
+    EXPECT_THROW(DeviceFilter(nlohmann::json{{"exclude", {""}}}), std::invalid_argument);
+    EXPECT_THROW(DeviceFilter(nlohmann::json{{"exclude", {1}}}), std::invalid_argument);
+}
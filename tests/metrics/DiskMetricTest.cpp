@@ -0,0 +1,119 @@
+#include "metrics/DiskMetric.hpp"
+#include "TempDir.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+// Тесты на поддельном корне /proc
+class DiskMetricTest : public ::testing::Test {
+protected:
+    // Устройство: операции, секторы и мс чтения и записи, мс занятости
+    struct Device {
+        std::string name;
+        uint64_t reads, sectors_read, read_ms, writes, sectors_written, write_ms, io_ms;
+    };
+
+    void write_stats(const std::vector<Device> &devices) {
+        std::ofstream file(root + "/diskstats");
+        for (const auto &d : devices) {
+            file << " 259       0 " << d.name << " " << d.reads << " 0 " << d.sectors_read
+                 << " " << d.read_ms << " " << d.writes << " 0 " << d.sectors_written << " "
+                 << d.write_ms << " 0 " << d.io_ms << " 0 0 0 0 0 0 0\n";
+        }
+    }
+
+    std::map<std::string, double> collect(const DiskMetric &metric) {
+        return std::get<std::map<std::string, double>>(metric.collect());
+    }
+
+    TempDir dir{"disk_test"};
+    std::string root = dir.path();
+};
+
+TEST_F(DiskMetricTest, Name) {
+    write_stats({});
+    DiskMetric metric(json{{"proc_root", root}});
+    EXPECT_EQ(metric.name(), "disk");
+    EXPECT_TRUE(metric.is_valid());
+}
+
+TEST_F(DiskMetricTest, MissingFile) {
+    DiskMetric metric(json{{"proc_root", root}});
+    EXPECT_FALSE(metric.is_valid());
+    EXPECT_TRUE(collect(metric).empty());
+}
+
+TEST_F(DiskMetricTest, RatesAndLatency) {
+    write_stats({{"nvme0n1", 100, 800, 50, 10, 80, 20, 60}});
+    DiskMetric metric(json{{"proc_root", root}});
+    EXPECT_TRUE(collect(metric).empty());
+
+    // 30 чтений по 4 КБ и 10 записей, суммарно 120 мс ожидания
+    write_stats({{"nvme0n1", 130, 800 + 240, 50 + 90, 20, 80 + 80, 20 + 30, 70}});
+    usleep(10000);
+    auto stats = collect(metric);
+
+    ASSERT_EQ(stats.size(), 6u);
+    EXPECT_GT(stats["nvme0n1.read_iops"], 0.0);
+    EXPECT_NEAR(stats["nvme0n1.read_iops"] / stats["nvme0n1.write_iops"], 3.0, 1e-6);
+    EXPECT_NEAR(stats["nvme0n1.read_bytes"] / stats["nvme0n1.read_iops"], 4096.0, 1e-6);
+    EXPECT_NEAR(stats["nvme0n1.write_bytes"] / stats["nvme0n1.write_iops"], 4096.0, 1e-6);
+    EXPECT_DOUBLE_EQ(stats["nvme0n1.await_ms"], 3.0);
+    EXPECT_GT(stats["nvme0n1.util"], 0.0);
+    EXPECT_LE(stats["nvme0n1.util"], 100.0);
+}
+
+TEST_F(DiskMetricTest, IdleDeviceHasZeroLatency) {
+    write_stats({{"sda", 5, 5, 5, 5, 5, 5, 5}});
+    DiskMetric metric(json{{"proc_root", root}});
+    collect(metric);
+    usleep(1000);
+    auto stats = collect(metric);
+    EXPECT_EQ(stats["sda.await_ms"], 0.0);
+    EXPECT_EQ(stats["sda.read_iops"], 0.0);
+}
+
+TEST_F(DiskMetricTest, IncludeFilter) {
+    write_stats({{"loop0", 1, 1, 1, 1, 1, 1, 1},
+                 {"nvme0n1", 1, 1, 1, 1, 1, 1, 1},
+                 {"nvme0n1p1", 1, 1, 1, 1, 1, 1, 1}});
+    DiskMetric metric(json{{"proc_root", root},
+                           {"include", {"nvme*", "sd?"}},
+                           {"exclude", {"*p?"}}});
+    collect(metric);
+    usleep(1000);
+    auto stats = collect(metric);
+    EXPECT_EQ(stats.size(), 6u);
+    EXPECT_EQ(stats.count("nvme0n1.util"), 1u);
+}
+
+TEST_F(DiskMetricTest, WindowRateCoversReadTime) {
+    // Счётчик растёт посреди окна: чтение после окна должно увидеть прирост,
+    // а скорость - делиться на фактический интервал между чтениями
+    write_stats({{"sda", 0, 0, 0, 0, 0, 0, 0}});
+    DiskMetric metric(json{{"proc_root", root}, {"window_ms", 100}});
+
+    std::thread writer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        write_stats({{"sda", 100, 800, 100, 0, 0, 0, 50}});
+    });
+    auto stats = collect(metric);
+    writer.join();
+
+    ASSERT_EQ(stats.size(), 6u);
+    // 100 чтений за окно не меньше 100 мс: не больше 1000 в секунду
+    EXPECT_LE(stats["sda.read_iops"], 1000.0 * 1.001);
+    EXPECT_GE(stats["sda.read_iops"], 1000.0 * 0.5);
+}
+
+TEST_F(DiskMetricTest, Units) {
+    DiskMetric metric(json{{"proc_root", root}});
+    EXPECT_STREQ(metric.unit("sda.read_iops"), "IOPS");
+    EXPECT_STREQ(metric.unit("sda.write_bytes"), "B/s");
+    EXPECT_STREQ(metric.unit("sda.await_ms"), "ms");
+    EXPECT_STREQ(metric.unit("sda.util"), "%");
+}
@@ -1,4 +1,5 @@
 #include "metrics/MemoryMetric.hpp"
+#include "TempDir.hpp"
 #include <gtest/gtest.h>
 #include <variant>
 
@@ -88,4 +89,31 @@ TEST(MemoryMetricTest, MemoryValuesRange) {
         EXPECT_LE(memory["MemFree"], memory["MemTotal"]);
         EXPECT_LE(memory["MemAvailable"], memory["MemTotal"]);
     }
-}
\ No newline at end of file
+}
+TEST(MemoryMetricTest, FakeProcRoot) {
+    TempDir dir("memory_test");
+    dir.write("meminfo",
+              "MemTotal:       16384000 kB\n"
+              "MemFree:         2048000 kB\n"
+              "HugePages_Total:       4\n");
+    MemoryMetric metric(json{{"proc_root", dir.path()}, {"spec", {"MemFree", "HugePages_Total"}}});
+    ASSERT_TRUE(metric.is_valid());
+
+    auto memory = std::get<std::map<std::string, double>>(metric.collect());
+    ASSERT_EQ(memory.size(), 2u);
+    EXPECT_DOUBLE_EQ(memory["MemFree"], 2000.0);
+    EXPECT_DOUBLE_EQ(memory["HugePages_Total"], 4.0);
+
+    // Файл остаётся открытым и перечитывается с начала
+    dir.write("meminfo", "MemFree:         1024 kB\n");
+    memory = std::get<std::map<std::string, double>>(metric.collect());
+    ASSERT_EQ(memory.size(), 1u);
+    EXPECT_DOUBLE_EQ(memory["MemFree"], 1.0);
+}
+
+TEST(MemoryMetricTest, MissingProcRoot) {
+    TempDir dir("memory_test");
+    MemoryMetric metric(json{{"proc_root", dir.path()}, {"spec", {"MemFree"}}});
+    EXPECT_FALSE(metric.is_valid());
+    EXPECT_THROW(MemoryMetric(json{{"proc_root", 1}, {"spec", {"MemFree"}}}), std::invalid_argument);
+}
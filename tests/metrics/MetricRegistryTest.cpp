@@ -0,0 +1,46 @@
+#include "metrics/MetricLoader.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace {
+
+class RegistryTestMetric : public IMetric {
+public:
+    explicit RegistryTestMetric(const json &config) : value_(config.value("value", 0)) {}
+
+    MetricValue collect() const override { return value_; }
+    bool is_valid() const override { return true; }
+    std::string name() const override { return "registry_test"; }
+
+private:
+    int value_;
+};
+
+const bool registered = MetricRegistry::instance().add(
+    "registry_test", [](const json &config) -> IMetric* { return new RegistryTestMetric(config); },
+    [](IMetric* metric) { delete metric; });
+
+} // namespace
+
+TEST(MetricRegistryTest, FindRegistered) {
+    EXPECT_TRUE(registered);
+    EXPECT_NE(MetricRegistry::instance().find("registry_test"), nullptr);
+    EXPECT_EQ(MetricRegistry::instance().find("no_such_metric"), nullptr);
+}
+
+TEST(MetricRegistryTest, DuplicateRegistration) {
+    EXPECT_FALSE(MetricRegistry::instance().add("registry_test", nullptr, nullptr));
+}
+
+TEST(MetricRegistryTest, LoadBuiltin) {
+    ASSERT_TRUE(MetricLoader::hasBuiltin("registry_test"));
+    auto metric = MetricLoader::loadBuiltin("registry_test", json{{"value", 42}});
+    ASSERT_TRUE(metric && metric->get());
+    EXPECT_EQ(metric->get()->name(), "registry_test");
+    EXPECT_EQ(std::get<int>(metric->get()->collect()), 42);
+}
+
+TEST(MetricRegistryTest, LoadUnknownBuiltin) {
+    EXPECT_FALSE(MetricLoader::hasBuiltin("no_such_metric"));
+    EXPECT_THROW(MetricLoader::loadBuiltin("no_such_metric", json::object()), std::runtime_error);
+}
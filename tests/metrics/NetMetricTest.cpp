@@ -0,0 +1,151 @@
+#include "metrics/NetMetric.hpp"
+#include "TempDir.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+// Тесты на поддельном корне /proc
+class NetMetricTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir.make_dirs("net");
+    }
+
+    // Интерфейс: имя, принятые байты и пакеты, отправленные байты и пакеты
+    struct Interface {
+        std::string name;
+        uint64_t rx_bytes, rx_packets, tx_bytes, tx_packets;
+    };
+
+    void write_dev(const std::vector<Interface> &interfaces) {
+        std::ofstream file(root + "/net/dev");
+        file << "Inter-|   Receive                                                |  Transmit\n"
+             << " face |bytes    packets errs drop fifo frame compressed multicast|"
+                "bytes    packets errs drop fifo colls carrier compressed\n";
+        for (const auto &i : interfaces) {
+            file << "  " << i.name << ": " << i.rx_bytes << " " << i.rx_packets
+                 << " 0 0 0 0 0 0 " << i.tx_bytes << " " << i.tx_packets << " 0 0 0 0 0 0\n";
+        }
+    }
+
+    std::map<std::string, double> collect(const NetMetric &metric) {
+        return std::get<std::map<std::string, double>>(metric.collect());
+    }
+
+    TempDir dir{"net_test"};
+    std::string root = dir.path();
+};
+
+TEST_F(NetMetricTest, Name) {
+    write_dev({});
+    NetMetric metric(json{{"proc_root", root}});
+    EXPECT_EQ(metric.name(), "net");
+    EXPECT_TRUE(metric.is_valid());
+}
+
+TEST_F(NetMetricTest, MissingFile) {
+    NetMetric metric(json{{"proc_root", root}});
+    EXPECT_FALSE(metric.is_valid());
+    EXPECT_TRUE(collect(metric).empty());
+}
+
+TEST_F(NetMetricTest, InvalidConfig) {
+    EXPECT_THROW(NetMetric(json{{"proc_root", 1}}), std::invalid_argument);
+    EXPECT_THROW(NetMetric(json{{"proc_root", root}, {"include", "eth*"}}),
+                 std::invalid_argument);
+}
+
+TEST_F(NetMetricTest, RatesAfterBaseline) {
+    write_dev({{"lo", 1000, 10, 1000, 10}, {"eth0", 5000, 50, 100, 1}});
+    NetMetric metric(json{{"proc_root", root}});
+    EXPECT_TRUE(collect(metric).empty());
+
+    write_dev({{"lo", 1000, 10, 1000, 10}, {"eth0", 5000 + 1500 * 20, 70, 100 + 600, 4}});
+    usleep(10000);
+    auto rates = collect(metric);
+
+    ASSERT_EQ(rates.size(), 8u);
+    EXPECT_EQ(rates["lo.rx_bytes"], 0.0);
+    EXPECT_GT(rates["eth0.rx_bytes"], 0.0);
+    // Отношение скоростей не зависит от интервала
+    EXPECT_NEAR(rates["eth0.rx_bytes"] / rates["eth0.rx_packets"], 1500.0, 1e-6);
+    EXPECT_NEAR(rates["eth0.tx_bytes"] / rates["eth0.tx_packets"], 200.0, 1e-6);
+}
+
+TEST_F(NetMetricTest, FiltersAndDisappearingInterfaces) {
+    write_dev({{"lo", 1, 1, 1, 1}, {"eth0", 1, 1, 1, 1}, {"veth1a", 1, 1, 1, 1}});
+    NetMetric metric(json{{"proc_root", root}, {"exclude", {"lo", "veth*"}}});
+    collect(metric);
+
+    write_dev({{"lo", 2, 2, 2, 2}, {"veth1a", 2, 2, 2, 2}, {"eth1", 2, 2, 2, 2}});
+    usleep(1000);
+    auto rates = collect(metric);
+    // eth0 исчез, eth1 только появился - значений ещё нет
+    EXPECT_TRUE(rates.empty());
+
+    write_dev({{"lo", 3, 3, 3, 3}, {"eth1", 3, 3, 3, 3}, {"eth0", 3, 3, 3, 3}});
+    usleep(1000);
+    rates = collect(metric);
+    EXPECT_EQ(rates.count("eth1.rx_bytes"), 1u);
+    EXPECT_EQ(rates.count("eth0.rx_bytes"), 0u);
+    EXPECT_EQ(rates.count("lo.rx_bytes"), 0u);
+}
+
+TEST_F(NetMetricTest, WindowGivesRatesOnFirstCollect) {
+    write_dev({{"eth0", 5000, 50, 100, 1}});
+    NetMetric metric(json{{"proc_root", root}, {"window_ms", 20}});
+
+    write_dev({{"eth0", 5000 + 1500 * 20, 70, 100, 1}});
+    auto rates = collect(metric);
+    ASSERT_EQ(rates.size(), 4u);
+    EXPECT_NEAR(rates["eth0.rx_bytes"] / rates["eth0.rx_packets"], 1500.0, 1e-6);
+
+    EXPECT_THROW(NetMetric(json{{"proc_root", root}, {"window_ms", -1}}), std::invalid_argument);
+}
+
+TEST_F(NetMetricTest, WindowRateCoversReadTime) {
+    // Счётчик растёт посреди окна: чтение после окна должно увидеть прирост,
+    // а скорость - делиться на фактический интервал между чтениями
+    write_dev({{"eth0", 0, 0, 0, 0}});
+    NetMetric metric(json{{"proc_root", root}, {"window_ms", 100}});
+
+    std::thread writer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        write_dev({{"eth0", 100000, 100, 0, 0}});
+    });
+    auto rates = collect(metric);
+    writer.join();
+
+    ASSERT_EQ(rates.size(), 4u);
+    // 100000 байт за окно не меньше 100 мс: не больше 1e6 байт/с
+    EXPECT_LE(rates["eth0.rx_bytes"], 1e6 * 1.001);
+    EXPECT_GE(rates["eth0.rx_bytes"], 1e6 * 0.5);
+}
+
+TEST_F(NetMetricTest, RecreatedInterfaceRestartsBaseline) {
+    write_dev({{"veth0", 3000000000ull, 100, 0, 0}});
+    NetMetric metric(json{{"proc_root", root}});
+    collect(metric);
+
+    // veth0 пересоздан под тем же именем: счётчики начались заново
+    write_dev({{"veth0", 1000, 1, 0, 0}});
+    usleep(1000);
+    EXPECT_TRUE(collect(metric).empty());
+
+    write_dev({{"veth0", 2000, 2, 0, 0}});
+    usleep(1000);
+    auto rates = collect(metric);
+    ASSERT_EQ(rates.size(), 4u);
+    EXPECT_LT(rates["veth0.rx_bytes"], 1e7);
+    EXPECT_GT(rates["veth0.rx_bytes"], 0.0);
+}
+
+TEST_F(NetMetricTest, Units) {
+    NetMetric metric(json{{"proc_root", root}});
+    EXPECT_STREQ(metric.unit("eth0.rx_bytes"), "B/s");
+    EXPECT_STREQ(metric.unit("eth0.tx_packets"), "pkt/s");
+}
@@ -0,0 +1,141 @@
+#include "metrics/MemoryMetric.hpp"
+#include "metrics/NumaMemory.hpp"
+#include "TempDir.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// Тесты на поддельном дереве sysfs с узлами 0, 1 и 3
+class NumaMemoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Не узлы: должны игнорироваться
+        dir.make_dirs("devices/system/node/power");
+        dir.make_dirs("devices/system/node/nodeX");
+
+        for (int node : {0, 1, 3}) {
+            std::filesystem::create_directories(node_dir(node));
+            write_meminfo(node, 2048 * (node + 1), 1024 * (node + 1));
+            write_file(node_dir(node) + "/numastat",
+                       "numa_hit " + std::to_string(256 * (node + 1)) + "\n"
+                       "numa_miss 0\n"
+                       "local_node 100\n");
+        }
+    }
+
+    std::string node_dir(int node) const {
+        return root + "/devices/system/node/node" + std::to_string(node);
+    }
+
+    void write_meminfo(int node, long total_kb, long free_kb) {
+        std::string n = std::to_string(node);
+        write_file(node_dir(node) + "/meminfo",
+                   "Node " + n + " MemTotal:       " + std::to_string(total_kb) + " kB\n"
+                   "Node " + n + " MemFree:        " + std::to_string(free_kb) + " kB\n"
+                   "Node " + n + " MemUsed:        " + std::to_string(total_kb - free_kb) + " kB\n"
+                   "Node " + n + " HugePages_Total:     4\n");
+    }
+
+    void write_file(const std::string &path, const std::string &content) {
+        std::ofstream file(path);
+        file << content;
+    }
+
+    TempDir dir{"numa_test"};
+    std::string root = dir.path();
+};
+
+TEST_F(NumaMemoryTest, DiscoversNodesOnce) {
+    NumaMemory numa(root, {"MemFree"}, {});
+    std::vector<int> expected = {0, 1, 3};
+    EXPECT_EQ(numa.nodes(), expected);
+
+    // Узлы, появившиеся позже, не подхватываются
+    std::filesystem::create_directories(node_dir(5));
+    numa.refresh();
+    EXPECT_EQ(numa.nodes(), expected);
+}
+
+TEST_F(NumaMemoryTest, DenseNodeFieldLayout) {
+    NumaMemory numa(root, {"HugePages_Total", "MemFree", "MemTotal"}, {"numa_hit"});
+    numa.refresh();
+
+    ASSERT_EQ(numa.fields().size(), 4u);
+    ASSERT_EQ(numa.values().size(), 3u * 4u);
+    for (size_t node = 0; node < 3; ++node) {
+        double scale = numa.nodes()[node] + 1;
+        EXPECT_DOUBLE_EQ(numa.value(node, 0), 4.0);  // Без единиц - как есть
+        EXPECT_DOUBLE_EQ(numa.value(node, 1), 1.0 * scale);
+        EXPECT_DOUBLE_EQ(numa.value(node, 2), 2.0 * scale);
+        // numastat в страницах переводится в МБ
+        double page_mb = static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+        EXPECT_DOUBLE_EQ(numa.value(node, 3), 256.0 * scale * page_mb);
+        EXPECT_DOUBLE_EQ(numa.values()[node * 4 + 1], numa.value(node, 1));
+    }
+}
+
+TEST_F(NumaMemoryTest, MissingFieldIsNaN) {
+    NumaMemory numa(root, {"NoSuchField"}, {"no_such_counter"});
+    numa.refresh();
+    EXPECT_TRUE(std::isnan(numa.value(0, 0)));
+    EXPECT_TRUE(std::isnan(numa.value(0, 1)));
+}
+
+TEST_F(NumaMemoryTest, RereadsOpenFiles) {
+    for (size_t threads : {1u, 2u, 3u}) {
+        NumaMemory numa(root, {"MemFree"}, {}, threads);
+        EXPECT_EQ(numa.threads(), threads);
+        numa.refresh();
+        EXPECT_DOUBLE_EQ(numa.value(2, 0), 4.0);
+
+        write_meminfo(3, 8192, 3072);
+        numa.refresh();
+        EXPECT_DOUBLE_EQ(numa.value(2, 0), 3.0);
+        write_meminfo(3, 8192, 4096);
+    }
+}
+
+TEST_F(NumaMemoryTest, ThreadsLimitedByNodes) {
+    NumaMemory numa(root, {"MemFree"}, {}, 16);
+    EXPECT_EQ(numa.threads(), 3u);
+}
+
+TEST_F(NumaMemoryTest, NoNodes) {
+    NumaMemory numa(root + "/missing", {"MemFree"}, {"numa_hit"});
+    EXPECT_TRUE(numa.nodes().empty());
+    EXPECT_NO_THROW(numa.refresh());
+    EXPECT_TRUE(numa.values().empty());
+}
+
+TEST_F(NumaMemoryTest, MemoryMetricReportsPerNodeFields) {
+    MemoryMetric metric(json{{"spec", {"MemTotal", "MemFree"}},
+                             {"numa", true},
+                             {"sysfs_root", root},
+                             {"numastat", {"numa_miss"}}});
+    ASSERT_TRUE(metric.is_valid());
+
+    auto memory = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_GT(memory["MemTotal"], 0.0);
+    EXPECT_DOUBLE_EQ(memory["node0.MemTotal"], 2.0);
+    EXPECT_DOUBLE_EQ(memory["node3.MemFree"], 4.0);
+    EXPECT_DOUBLE_EQ(memory["node1.numa_miss"], 0.0);
+    EXPECT_EQ(memory.count("node1.numa_hit"), 0u);
+    EXPECT_EQ(memory.count("node2.MemFree"), 0u);
+}
+
+TEST_F(NumaMemoryTest, MemoryMetricInvalidNumaConfig) {
+    json spec = {"MemFree"};
+    EXPECT_THROW(MemoryMetric(json{{"spec", spec}, {"numa", 1}}), std::invalid_argument);
+    EXPECT_THROW(MemoryMetric(json{{"spec", spec}, {"numa", true}, {"sysfs_root", 1}}),
+                 std::invalid_argument);
+    EXPECT_THROW(MemoryMetric(json{{"spec", spec}, {"numa", true}, {"numastat", "numa_hit"}}),
+                 std::invalid_argument);
+    EXPECT_THROW(MemoryMetric(json{{"spec", spec}, {"numa", true},
+                                   {"numastat", {"numa_hit", "numa_hit"}}}),
+                 std::invalid_argument);
+    EXPECT_THROW(MemoryMetric(json{{"spec", spec}, {"numa", true}, {"numa_threads", 0}}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,210 @@
+#include "metrics/PSIMetric.hpp"
+#include "TempDir.hpp"
+#include "core/EventQueue.hpp"
+#include "output/IOutput.hpp"
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// Соединение TCP через loopback: срочные данные (MSG_OOB) дают на приёмном
+// конце POLLPRI, как срабатывание триггера PSI в ядре
+struct UrgentPair {
+    int sender = -1;
+    int receiver = -1;
+
+    UrgentPair() {
+        int listener = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+            listen(listener, 1) != 0 ||
+            getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            throw std::runtime_error("loopback listener failed");
+        }
+        sender = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (connect(sender, reinterpret_cast<sockaddr*>(&address), length) != 0) {
+            throw std::runtime_error("loopback connect failed");
+        }
+        receiver = accept(listener, nullptr, nullptr);
+        close(listener);
+    }
+
+    ~UrgentPair() {
+        if (sender >= 0) {
+            close(sender);
+        }
+    }
+
+    void fire() const { send(sender, "!", 1, MSG_OOB); }
+};
+
+// Выход, запоминающий внеочередные значения
+class EventRecorder : public IOutput {
+public:
+    using IOutput::write;
+    void write(const Timestamp &,
+               const std::vector<std::pair<const IMetric*, MetricValue>> &) override {}
+    bool is_valid() const override { return true; }
+    void write_event(const Timestamp &, const IMetric* metric, const MetricValue &value) override {
+        events.emplace_back(metric, value);
+    }
+
+    std::vector<std::pair<const IMetric*, MetricValue>> events;
+};
+
+} // namespace
+
+// Тесты на поддельном корне /proc
+class PSIMetricTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir.make_dirs("pressure");
+        write_file("cpu",
+                   "some avg10=1.50 avg60=0.75 avg300=0.10 total=123456\n"
+                   "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+        write_file("memory",
+                   "some avg10=12.00 avg60=3.00 avg300=1.00 total=999\n"
+                   "full avg10=4.25 avg60=1.00 avg300=0.50 total=500\n");
+    }
+
+    void write_file(const std::string &name, const std::string &content) {
+        dir.write("pressure/" + name, content);
+    }
+
+    TempDir dir{"psi_test"};
+    std::string root = dir.path();
+};
+
+TEST_F(PSIMetricTest, Name) {
+    PSIMetric metric(json{{"proc_root", root}});
+    EXPECT_EQ(metric.name(), "psi");
+    EXPECT_TRUE(metric.is_valid());
+}
+
+TEST_F(PSIMetricTest, InvalidConfig) {
+    EXPECT_THROW(PSIMetric(json{{"resources", {"disk"}}}), std::invalid_argument);
+    EXPECT_THROW(PSIMetric(json{{"resources", {"cpu", "cpu"}}}), std::invalid_argument);
+    EXPECT_THROW(PSIMetric(json{{"proc_root", root},
+                                {"resources", {"cpu"}},
+                                {"triggers", {{{"resource", "memory"}, {"stall_us", 1000}}}}}),
+                 std::invalid_argument);
+    EXPECT_THROW(PSIMetric(json{{"proc_root", root},
+                                {"triggers", {{{"resource", "memory"}, {"stall_us", 1000},
+                                               {"window_us", 100}}}}}),
+                 std::invalid_argument);
+    EXPECT_THROW(PSIMetric(json{{"proc_root", root},
+                                {"triggers", {{{"resource", "memory"}, {"type", "half"},
+                                               {"stall_us", 1000}}}}}),
+                 std::invalid_argument);
+}
+
+TEST_F(PSIMetricTest, CollectFromFakeRoot) {
+    PSIMetric metric(json{{"proc_root", root}});
+    auto values = std::get<std::map<std::string, double>>(metric.collect());
+
+    EXPECT_DOUBLE_EQ(values["cpu.some.avg10"], 1.5);
+    EXPECT_DOUBLE_EQ(values["cpu.some.total"], 123456.0);
+    EXPECT_DOUBLE_EQ(values["memory.some.avg10"], 12.0);
+    EXPECT_DOUBLE_EQ(values["memory.full.avg10"], 4.25);
+    EXPECT_DOUBLE_EQ(values["memory.full.total"], 500.0);
+    // io отсутствует в поддельном корне - просто пропускается
+    EXPECT_EQ(values.count("io.some.avg10"), 0u);
+}
+
+TEST_F(PSIMetricTest, CollectSeesUpdatedFile) {
+    PSIMetric metric(json{{"proc_root", root}, {"resources", {"cpu"}}});
+    std::get<std::map<std::string, double>>(metric.collect());
+
+    write_file("cpu", "some avg10=50.00 avg60=0.75 avg300=0.10 total=123999\n");
+    auto values = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_DOUBLE_EQ(values["cpu.some.avg10"], 50.0);
+    EXPECT_EQ(values.count("cpu.full.avg10"), 0u);
+}
+
+TEST_F(PSIMetricTest, TriggerFallsBackToPolling) {
+    // Триггер на отсутствующий файл не регистрируется, опрос продолжает работать
+    PSIMetric metric(json{{"proc_root", root},
+                          {"resources", {"cpu", "io"}},
+                          {"triggers", {{{"resource", "io"}, {"stall_us", 100000}}}}});
+    EXPECT_EQ(metric.active_triggers(), 0u);
+
+    int events = 0;
+    metric.set_event_callback([&events](const IMetric*, MetricValue) { ++events; });
+
+    auto values = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_DOUBLE_EQ(values["cpu.some.avg10"], 1.5);
+    EXPECT_EQ(events, 0);
+}
+
+TEST_F(PSIMetricTest, WatcherStopsCleanly) {
+    // Обычный файл принимает запись триггера, но никогда не сигналит POLLPRI
+    {
+        PSIMetric metric(json{{"proc_root", root},
+                              {"resources", {"memory"}},
+                              {"triggers", {{{"resource", "memory"}, {"stall_us", 100000}}}}});
+        EXPECT_EQ(metric.active_triggers(), 1u);
+        metric.set_event_callback([](const IMetric*, MetricValue) {});
+    }
+    SUCCEED();
+}
+
+TEST_F(PSIMetricTest, TriggerDeliversEventToOutputs) {
+    // Дескриптор триггера подменяется сокетом, срочные данные будят поток
+    // ожидания; значение проходит через очередь до write_event выхода
+    UrgentPair trigger;
+    std::string registered;
+    PSIMetric metric(json{{"proc_root", root},
+                          {"resources", {"memory"}},
+                          {"triggers", {{{"resource", "memory"}, {"stall_us", 150000}}}}},
+                     [&](const std::string &resource, const std::string &spec) {
+                         registered = resource + ": " + spec;
+                         return trigger.receiver;
+                     });
+    ASSERT_EQ(metric.active_triggers(), 1u);
+    EXPECT_EQ(registered, "memory: some 150000 1000000");
+
+    EventQueue queue;
+    metric.set_event_callback(queue.callback());
+    trigger.fire();
+
+    std::vector<EventQueue::Event> pending;
+    ASSERT_TRUE(queue.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(5),
+                                 pending));
+    EventRecorder output;
+    for (const auto &event : pending) {
+        output.write_event(event.tick, event.metric, event.value);
+    }
+
+    ASSERT_FALSE(output.events.empty());
+    EXPECT_EQ(output.events[0].first, &metric);
+    auto values = std::get<std::map<std::string, double>>(output.events[0].second);
+    EXPECT_DOUBLE_EQ(values["memory.some.avg10"], 12.0);
+    EXPECT_DOUBLE_EQ(values["memory.full.total"], 500.0);
+    EXPECT_DOUBLE_EQ(values["memory.some.trigger"], 1.0);
+}
+
+TEST(PSIMetricSystemTest, CollectFromProc) {
+    if (access("/proc/pressure/cpu", R_OK) != 0) {
+        GTEST_SKIP() << "PSI is not available on this system";
+    }
+
+    PSIMetric metric(json{{"resources", {"cpu"}}});
+    auto values = std::get<std::map<std::string, double>>(metric.collect());
+    EXPECT_TRUE(values.count("cpu.some.avg10"));
+    EXPECT_GE(values["cpu.some.total"], 0.0);
+}
+
+TEST_F(PSIMetricTest, Units) {
+    PSIMetric metric(json{{"proc_root", root}});
+    EXPECT_STREQ(metric.unit("cpu.some.avg10"), "%");
+    EXPECT_STREQ(metric.unit("memory.full.total"), "us");
+    EXPECT_STREQ(metric.unit("memory.some.trigger"), "");
+}
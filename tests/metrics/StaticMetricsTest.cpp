@@ -0,0 +1,36 @@
+#include "metrics/MetricLoader.hpp"
+#include <gtest/gtest.h>
+#include <map>
+#include <variant>
+#include <vector>
+
+// Собирается только со STATUS_MONITOR_STATIC_METRICS: встроенные метрики
+// регистрируются через STATUS_MONITOR_METRIC при статической инициализации
+
+TEST(StaticMetricsTest, BuiltinsRegistered) {
+    for (const char* type : {"cpu", "memory", "net", "disk", "psi"}) {
+        EXPECT_TRUE(MetricLoader::hasBuiltin(type)) << type;
+    }
+}
+
+TEST(StaticMetricsTest, LoadCpu) {
+    auto metric = MetricLoader::loadBuiltin("cpu", json{{"cpu_ids", {0}}, {"window_ms", 20}});
+    ASSERT_TRUE(metric && metric->get());
+    EXPECT_EQ(metric->get()->name(), "cpu");
+    ASSERT_TRUE(metric->get()->is_valid());
+
+    auto usage = std::get<std::vector<double>>(metric->get()->collect());
+    ASSERT_EQ(usage.size(), 1u);
+    EXPECT_GE(usage[0], 0.0);
+    EXPECT_LE(usage[0], 100.0);
+}
+
+TEST(StaticMetricsTest, LoadMemory) {
+    auto metric = MetricLoader::loadBuiltin("memory", json{{"spec", {"MemTotal"}}});
+    ASSERT_TRUE(metric && metric->get());
+    EXPECT_EQ(metric->get()->name(), "memory");
+    ASSERT_TRUE(metric->get()->is_valid());
+
+    auto memory = std::get<std::map<std::string, double>>(metric->get()->collect());
+    EXPECT_GT(memory["MemTotal"], 0.0);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// Временный каталог для поддельных корней /proc и /sys в тестах метрик.
+// Создаётся в конструкторе и удаляется вместе с содержимым в деструкторе.
+class TempDir {
+public:
+    explicit TempDir(const std::string &prefix) {
+        std::string pattern =
+            (std::filesystem::temp_directory_path() / (prefix + "_XXXXXX")).string();
+        if (!mkdtemp(pattern.data())) {
+            throw std::runtime_error("mkdtemp failed for " + pattern);
+        }
+        path_ = pattern;
+    }
+
+    ~TempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    TempDir(const TempDir &) = delete;
+    TempDir &operator=(const TempDir &) = delete;
+
+    const std::string &path() const { return path_; }
+
+    // Создаёт подкаталог вместе с недостающими родительскими
+    void make_dirs(const std::string &relative) const {
+        std::filesystem::create_directories(std::filesystem::path(path_) / relative);
+    }
+
+    // Перезаписывает файл относительно корня
+    void write(const std::string &relative, const std::string &content) const {
+        std::ofstream file(std::filesystem::path(path_) / relative);
+        file << content;
+    }
+
+private:
+    std::string path_;
+};
@@ -0,0 +1,47 @@
+#include "metrics/UsageAccumulator.hpp"
+#include <gtest/gtest.h>
+
+TEST(UsageAccumulatorTest, Empty) {
+    UsageAccumulator accumulator;
+    EXPECT_EQ(accumulator.count(), 0u);
+    EXPECT_EQ(accumulator.mean(), 0.0);
+    EXPECT_EQ(accumulator.percentile(0.95), 0.0);
+}
+
+TEST(UsageAccumulatorTest, MinMaxMean) {
+    UsageAccumulator accumulator;
+    accumulator.add(10.0);
+    accumulator.add(20.0);
+    accumulator.add(60.0);
+
+    EXPECT_EQ(accumulator.count(), 3u);
+    EXPECT_DOUBLE_EQ(accumulator.min(), 10.0);
+    EXPECT_DOUBLE_EQ(accumulator.max(), 60.0);
+    EXPECT_DOUBLE_EQ(accumulator.mean(), 30.0);
+}
+
+TEST(UsageAccumulatorTest, PercentileCatchesSpikes) {
+    UsageAccumulator accumulator;
+    // 5 секунд по 50 мс: в основном простой и короткий всплеск до 100%
+    for (int i = 0; i < 90; ++i) {
+        accumulator.add(5.0);
+    }
+    for (int i = 0; i < 10; ++i) {
+        accumulator.add(100.0);
+    }
+
+    EXPECT_LT(accumulator.mean(), 15.0);
+    EXPECT_DOUBLE_EQ(accumulator.percentile(0.95), 100.0);
+    EXPECT_NEAR(accumulator.percentile(0.5), 5.0, 100.0 / UsageAccumulator::kBins);
+}
+
+TEST(UsageAccumulatorTest, ClampsAndResets) {
+    UsageAccumulator accumulator;
+    accumulator.add(-5.0);
+    accumulator.add(150.0);
+    EXPECT_DOUBLE_EQ(accumulator.min(), 0.0);
+    EXPECT_DOUBLE_EQ(accumulator.max(), 100.0);
+
+    accumulator.reset();
+    EXPECT_EQ(accumulator.count(), 0u);
+}
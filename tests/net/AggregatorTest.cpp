@@ -0,0 +1,194 @@
+#include "net/Aggregator.hpp"
+#include "FakeMetric.hpp"
+#include "output/StreamOutput.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <set>
+#include <unistd.h>
+
+namespace {
+
+using Values = std::vector<std::pair<const IMetric*, MetricValue>>;
+
+// Прокачивает события агрегатора и агентов, пока не соберутся данные от nodes узлов
+std::map<std::string, MetricValue> gather(Aggregator &aggregator,
+                                          std::vector<std::unique_ptr<StreamOutput>> &agents,
+                                          size_t nodes) {
+    std::map<std::string, MetricValue> result;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (result.size() < nodes && std::chrono::steady_clock::now() < deadline) {
+        for (auto &agent : agents) {
+            agent->flush();
+        }
+        aggregator.poll(10);
+        for (auto &[metric, value] : aggregator.collect()) {
+            result[metric->name()] = value;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(AggregatorTest, InvalidConfig) {
+    EXPECT_THROW(Aggregator(json::object()), std::invalid_argument);
+    EXPECT_THROW(Aggregator(json{{"listen", "udp://127.0.0.1:1"}}), std::invalid_argument);
+}
+
+TEST(AggregatorTest, MergesSeveralTcpAgents) {
+    Aggregator aggregator(json{{"listen", "tcp://127.0.0.1:0"}});
+    ASSERT_NE(aggregator.endpoint().port, 0);
+
+    FakeMetric metric("cpu");
+    std::vector<std::unique_ptr<StreamOutput>> agents;
+    for (int i = 0; i < 4; ++i) {
+        agents.push_back(std::make_unique<StreamOutput>(
+            json{{"address", aggregator.endpoint().to_string()}, {"node", "node" + std::to_string(i)}}));
+        ASSERT_TRUE(agents.back()->is_valid());
+        agents.back()->write(Values{{&metric, std::vector<double>{double(i), 50.0}}});
+    }
+
+    auto result = gather(aggregator, agents, 4);
+    ASSERT_EQ(result.size(), 4u);
+    EXPECT_EQ(aggregator.node_count(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        auto usage = std::get<std::vector<double>>(result.at("node" + std::to_string(i) + "/cpu"));
+        EXPECT_EQ(usage, (std::vector<double>{double(i), 50.0}));
+    }
+
+    // Следующие тики идут без повторной схемы
+    agents[2]->write(Values{{&metric, std::vector<double>{7.0, 8.0}}});
+    result = gather(aggregator, agents, 1);
+    ASSERT_EQ(result.size(), 1u);
+    auto usage = std::get<std::vector<double>>(result.at("node2/cpu"));
+    EXPECT_EQ(usage, (std::vector<double>{7.0, 8.0}));
+}
+
+TEST(AggregatorTest, UnixSocketAndSchemaChange) {
+    std::string path = "/tmp/status_monitor_test_" + std::to_string(getpid()) + ".sock";
+    Aggregator aggregator(json{{"listen", "unix:" + path}});
+
+    FakeMetric metric("cpu");
+    std::vector<std::unique_ptr<StreamOutput>> agents;
+    agents.push_back(std::make_unique<StreamOutput>(json{{"address", "unix:" + path}, {"node", "local"}}));
+
+    agents[0]->write(Values{{&metric, std::vector<double>{1.0}}});
+    auto result = gather(aggregator, agents, 1);
+    ASSERT_EQ(result.size(), 1u);
+
+    agents[0]->write(Values{{&metric, std::map<std::string, double>{{"MemFree", 42.0}}}});
+    result = gather(aggregator, agents, 1);
+    ASSERT_EQ(result.size(), 1u);
+    auto memory = std::get<std::map<std::string, double>>(result.at("local/cpu"));
+    EXPECT_EQ(memory.at("MemFree"), 42.0);
+}
+
+TEST(AggregatorTest, AgentBuffersUntilAggregatorStarts) {
+    std::string path = "/tmp/status_monitor_late_" + std::to_string(getpid()) + ".sock";
+    unlink(path.c_str());
+
+    FakeMetric metric("cpu");
+    std::vector<std::unique_ptr<StreamOutput>> agents;
+    agents.push_back(std::make_unique<StreamOutput>(
+        json{{"address", "unix:" + path}, {"node", "late"}, {"max_buffer", 256}}));
+
+    // Агрегатора ещё нет: кадры копятся, старые отбрасываются по лимиту
+    for (int i = 0; i < 20; ++i) {
+        agents[0]->write(Values{{&metric, std::vector<double>{double(i)}}});
+    }
+    EXPECT_FALSE(agents[0]->connected());
+    EXPECT_LE(agents[0]->buffered_bytes(), 256u);
+    EXPECT_GT(agents[0]->dropped_frames(), 0u);
+
+    Aggregator aggregator(json{{"listen", "unix:" + path}});
+    auto result = gather(aggregator, agents, 1);
+    ASSERT_EQ(result.size(), 1u);
+    // Последнее значение доходит после переподключения
+    auto usage = std::get<std::vector<double>>(result.at("late/cpu"));
+    EXPECT_EQ(usage, (std::vector<double>{19.0}));
+}
+
+TEST(AggregatorTest, EventsDoNotDisturbAgentStream) {
+    std::string path = "/tmp/status_monitor_event_" + std::to_string(getpid()) + ".sock";
+    unlink(path.c_str());
+
+    FakeMetric cpu("cpu");
+    FakeMetric psi("psi");
+    std::vector<std::unique_ptr<StreamOutput>> agents;
+    agents.push_back(std::make_unique<StreamOutput>(json{{"address", "unix:" + path}, {"node", "ev"}}));
+
+    // Пока агрегатора нет, в буфере лежат Hello, схема и значения. Событие
+    // между тиками не должно менять схему и выбрасывать эти кадры.
+    Values tick = {{&cpu, std::vector<double>{1.0, 2.0}},
+                   {&psi, std::map<std::string, double>{{"memory.some.avg10", 1.0}}}};
+    agents[0]->write(tick);
+    size_t buffered = agents[0]->buffered_bytes();
+    agents[0]->write_event(Timestamp::now(), &psi,
+                           std::map<std::string, double>{{"memory.some.avg10", 30.0},
+                                                         {"memory.some.trigger", 1.0}});
+    EXPECT_EQ(agents[0]->buffered_bytes(), buffered);
+    EXPECT_EQ(agents[0]->dropped_frames(), 0u);
+
+    Aggregator aggregator(json{{"listen", "unix:" + path}});
+    auto result = gather(aggregator, agents, 2);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(aggregator.node_count(), 1u);
+    EXPECT_EQ(std::get<std::vector<double>>(result.at("ev/cpu")),
+              (std::vector<double>{1.0, 2.0}));
+    auto psi_values = std::get<std::map<std::string, double>>(result.at("ev/psi"));
+    EXPECT_EQ(psi_values.size(), 1u);
+}
+
+TEST(AggregatorTest, SchemaChangeBeforeFirstFlush) {
+    std::string path = "/tmp/status_monitor_reschema_" + std::to_string(getpid()) + ".sock";
+    unlink(path.c_str());
+
+    FakeMetric metric("cpu");
+    std::vector<std::unique_ptr<StreamOutput>> agents;
+    agents.push_back(std::make_unique<StreamOutput>(json{{"address", "unix:" + path}, {"node", "early"}}));
+
+    // Схема меняется до первой успешной отправки: старые значения
+    // отбрасываются, а рукопожатие уходит уже с новой схемой
+    agents[0]->write(Values{{&metric, std::vector<double>{1.0, 2.0}}});
+    agents[0]->write(Values{{&metric, std::map<std::string, double>{{"MemFree", 42.0}}}});
+    EXPECT_EQ(agents[0]->dropped_frames(), 1u);
+
+    Aggregator aggregator(json{{"listen", "unix:" + path}});
+    auto result = gather(aggregator, agents, 1);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(aggregator.node_count(), 1u);
+    auto memory = std::get<std::map<std::string, double>>(result.at("early/cpu"));
+    EXPECT_EQ(memory.at("MemFree"), 42.0);
+}
+
+TEST(AggregatorTest, SchemaChangeKeepsPartlySentFrame) {
+    std::string path = "/tmp/status_monitor_partial_" + std::to_string(getpid()) + ".sock";
+    Aggregator aggregator(json{{"listen", "unix:" + path}});
+
+    FakeMetric metric("cpu");
+    std::vector<std::unique_ptr<StreamOutput>> agents;
+    agents.push_back(std::make_unique<StreamOutput>(
+        json{{"address", "unix:" + path}, {"node", "partial"}, {"max_buffer", 8 << 20}}));
+
+    // Агрегатор пока не читает: большой кадр застревает в сокете частично
+    agents[0]->write(Values{{&metric, std::vector<double>(200000, 1.0)}});
+    ASSERT_GT(agents[0]->buffered_bytes(), 0u);
+
+    // Новая схема не должна обрывать частично отправленный кадр
+    agents[0]->write(Values{{&metric, std::map<std::string, double>{{"MemFree", 7.0}}}});
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    std::map<std::string, MetricValue> result;
+    while (std::chrono::steady_clock::now() < deadline &&
+           !(result.count("partial/cpu") &&
+             std::holds_alternative<std::map<std::string, double>>(result["partial/cpu"]))) {
+        agents[0]->flush();
+        aggregator.poll(10);
+        for (auto &[relayed, value] : aggregator.collect()) {
+            result[relayed->name()] = value;
+        }
+    }
+
+    EXPECT_EQ(aggregator.node_count(), 1u);
+    auto memory = std::get<std::map<std::string, double>>(result.at("partial/cpu"));
+    EXPECT_EQ(memory.at("MemFree"), 7.0);
+}
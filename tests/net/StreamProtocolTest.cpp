@@ -0,0 +1,139 @@
+#include "net/StreamProtocol.hpp"
+#include "FakeMetric.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace {
+
+std::vector<FrameDecoder::Frame> decode_all(FrameDecoder &decoder) {
+    std::vector<FrameDecoder::Frame> frames;
+    FrameDecoder::Frame frame;
+    while (decoder.next(frame)) {
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+} // namespace
+
+TEST(StreamProtocolTest, RoundTrip) {
+    FakeMetric cpu("cpu");
+    FakeMetric memory("memory");
+    FakeMetric load("load");
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values = {
+        {&cpu, std::vector<double>{12.5, 99.0}},
+        {&memory, std::map<std::string, double>{{"MemFree", 100.5}, {"MemTotal", 8000.0}}},
+        {&load, 3}};
+
+    std::string stream;
+    StreamProtocol::encode_hello(stream, "node-1");
+    auto schema = StreamSchema::from(metric_values);
+    StreamProtocol::encode_schema(stream, schema);
+    StreamProtocol::encode_values(stream, 1700000000123, metric_values);
+
+    FrameDecoder decoder;
+    decoder.feed(stream.data(), stream.size());
+    auto frames = decode_all(decoder);
+    ASSERT_EQ(frames.size(), 3u);
+
+    EXPECT_EQ(frames[0].type, FrameType::Hello);
+    EXPECT_EQ(StreamProtocol::decode_hello(frames[0].payload), "node-1");
+
+    ASSERT_EQ(frames[1].type, FrameType::Schema);
+    auto decoded = StreamProtocol::decode_schema(frames[1].payload);
+    EXPECT_TRUE(decoded.matches(metric_values));
+    EXPECT_EQ(decoded.series_count(), 5u);
+
+    ASSERT_EQ(frames[2].type, FrameType::Values);
+    std::vector<double> values;
+    EXPECT_EQ(StreamProtocol::decode_values(frames[2].payload, values), 1700000000123u);
+    auto unpacked = decoded.unpack(values);
+    ASSERT_EQ(unpacked.size(), 3u);
+    EXPECT_EQ(std::get<std::vector<double>>(unpacked[0]), (std::vector<double>{12.5, 99.0}));
+    auto meminfo = std::get<std::map<std::string, double>>(unpacked[1]);
+    EXPECT_EQ(meminfo.at("MemTotal"), 8000.0);
+    EXPECT_EQ(std::get<double>(unpacked[2]), 3.0);
+}
+
+TEST(StreamProtocolTest, ValuesFrameIsCompact) {
+    FakeMetric cpu("cpu");
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values = {
+        {&cpu, std::vector<double>(64, 1.0)}};
+
+    std::string frame;
+    StreamProtocol::encode_values(frame, 0, metric_values);
+    EXPECT_EQ(frame.size(), StreamProtocol::kHeaderSize + 8 + 4 + 64 * sizeof(double));
+}
+
+TEST(StreamProtocolTest, DecoderHandlesPartialInput) {
+    std::string stream;
+    StreamProtocol::encode_hello(stream, "node");
+    StreamProtocol::encode_hello(stream, "other");
+
+    FrameDecoder decoder;
+    size_t frames = 0;
+    FrameDecoder::Frame frame;
+    for (char c : stream) {
+        decoder.feed(&c, 1);
+        while (decoder.next(frame)) {
+            ++frames;
+        }
+    }
+    EXPECT_EQ(frames, 2u);
+}
+
+TEST(StreamProtocolTest, SchemaMismatch) {
+    FakeMetric cpu("cpu");
+    std::vector<std::pair<const IMetric*, MetricValue>> two = {{&cpu, std::vector<double>{1, 2}}};
+    std::vector<std::pair<const IMetric*, MetricValue>> three = {{&cpu, std::vector<double>{1, 2, 3}}};
+
+    auto schema = StreamSchema::from(two);
+    EXPECT_TRUE(schema.matches(two));
+    EXPECT_FALSE(schema.matches(three));
+    EXPECT_THROW(schema.unpack({1.0}), std::runtime_error);
+
+    // Другой объект метрики сравнивается по имени
+    FakeMetric same("cpu");
+    FakeMetric other("load");
+    EXPECT_TRUE(schema.matches({{&same, std::vector<double>{1, 2}}}));
+    EXPECT_FALSE(schema.matches({{&other, std::vector<double>{1, 2}}}));
+}
+
+TEST(StreamProtocolTest, RejectsMalformedFrames) {
+    FrameDecoder decoder;
+    const char bad_type[] = {1, 0, 0, 0, 42, 0};
+    decoder.feed(bad_type, sizeof(bad_type));
+    FrameDecoder::Frame frame;
+    EXPECT_THROW(decoder.next(frame), std::runtime_error);
+
+    std::string truncated;
+    StreamProtocol::encode_hello(truncated, "node");
+    EXPECT_THROW(StreamProtocol::decode_hello(
+                     std::string_view(truncated).substr(StreamProtocol::kHeaderSize, 3)),
+                 std::runtime_error);
+
+    std::vector<double> values;
+    EXPECT_THROW(StreamProtocol::decode_values("short", values), std::runtime_error);
+}
+
+TEST(StreamProtocolTest, RejectsOverflowingSeriesCount) {
+    // Два вектора по 2^31 рядов: в 32 битах сумма обнулилась бы, и пустой
+    // кадр значений прошёл бы проверку размера
+    StreamSchema schema;
+    for (const char* name : {"a", "b"}) {
+        StreamSchema::Entry entry;
+        entry.name = name;
+        entry.kind = StreamSchema::Kind::Vector;
+        entry.count = 0x80000000u;
+        schema.entries.push_back(entry);
+    }
+
+    std::string frame;
+    StreamProtocol::encode_schema(frame, schema);
+    EXPECT_THROW(StreamProtocol::decode_schema(
+                     std::string_view(frame).substr(StreamProtocol::kHeaderSize)),
+                 std::runtime_error);
+
+    EXPECT_EQ(schema.series_count(), 0x100000000ull);
+    EXPECT_THROW(schema.unpack({}), std::runtime_error);
+}
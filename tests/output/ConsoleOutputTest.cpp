@@ -1,6 +1,7 @@
 #include "output/ConsoleOutput.hpp"
 #include "metrics/CPUMetric.hpp"
 #include "metrics/MemoryMetric.hpp"
+#include "FakeMetric.hpp"
 #include <gtest/gtest.h>
 
 TEST(ConsoleOutputTest, Write) {
@@ -22,3 +23,30 @@ TEST(ConsoleOutputTest, Write) {
     // Проверяем, что write не выбрасывает исключений
     EXPECT_NO_THROW(output.write(metric_values));
 }
+
+TEST(ConsoleOutputTest, DeadbandRedrawKeepsUnchangedSeries) {
+    ConsoleOutput output(json{{"deadband", {{"abs", 1.0}}}});
+    FakeMetric cpu("cpu");
+    FakeMetric net("net", "B/s");
+    auto write = [&](double core1, double rx) {
+        testing::internal::CaptureStdout();
+        output.write(std::vector<std::pair<const IMetric*, MetricValue>>{
+            {&cpu, std::vector<double>{10.0, core1}},
+            {&net, std::map<std::string, double>{{"eth0.rx", rx}, {"eth0.tx", 5.0}}},
+        });
+        return testing::internal::GetCapturedStdout();
+    };
+
+    write(20.0, 100.0);
+
+    // Изменилось одно ядро: экран перерисован целиком, остальные ряды на месте
+    std::string screen = write(25.0, 100.5);
+    EXPECT_NE(screen.find("CPU 0: 10.00%"), std::string::npos);
+    EXPECT_NE(screen.find("CPU 1: 25.00%"), std::string::npos);
+    // Сдвиг ниже порога показывает последнее выведенное значение
+    EXPECT_NE(screen.find("eth0.rx: 100.00 B/s"), std::string::npos);
+    EXPECT_NE(screen.find("eth0.tx: 5.00 B/s"), std::string::npos);
+
+    // Ничего не изменилось: экран не очищается и не перерисовывается
+    EXPECT_EQ(write(25.5, 100.0), "");
+}
@@ -0,0 +1,149 @@
+#include "output/Deadband.hpp"
+#include "FakeMetric.hpp"
+#include "output/FileOutput.hpp"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+using Values = std::vector<std::pair<const IMetric*, MetricValue>>;
+
+int64_t at(int seconds) {
+    return static_cast<int64_t>(seconds) * 1000000000;
+}
+
+} // namespace
+
+TEST(DeadbandTest, DisabledByDefault) {
+    Deadband deadband;
+    EXPECT_FALSE(deadband.enabled());
+}
+
+TEST(DeadbandTest, InvalidConfig) {
+    EXPECT_THROW(Deadband(json{{"abs", -1.0}}), std::invalid_argument);
+    EXPECT_THROW(Deadband(json{{"rel", "0.1"}}), std::invalid_argument);
+    EXPECT_THROW(Deadband(json::array()), std::invalid_argument);
+}
+
+TEST(DeadbandTest, FirstValueAlwaysEmitted) {
+    Deadband deadband(json{{"abs", 10.0}});
+    FakeMetric metric;
+
+    EXPECT_EQ(deadband.evaluate(at(0), {{&metric, std::vector<double>{1.0, 2.0}}}), 2u);
+    EXPECT_TRUE(deadband.emitted(&metric, 0));
+    EXPECT_TRUE(deadband.emitted(&metric, 1));
+}
+
+TEST(DeadbandTest, AbsoluteThreshold) {
+    Deadband deadband(json{{"abs", 1.0}});
+    FakeMetric metric;
+
+    deadband.evaluate(at(0), {{&metric, std::vector<double>{10.0, 10.0}}});
+    EXPECT_EQ(deadband.evaluate(at(1), {{&metric, std::vector<double>{10.5, 12.0}}}), 1u);
+    EXPECT_FALSE(deadband.emitted(&metric, 0));
+    EXPECT_TRUE(deadband.emitted(&metric, 1));
+    EXPECT_EQ(deadband.emitted_count(&metric), 1u);
+}
+
+TEST(DeadbandTest, RelativeThreshold) {
+    Deadband deadband(json{{"rel", 0.1}});
+    FakeMetric metric;
+
+    std::map<std::string, double> memory = {{"MemFree", 1000.0}, {"MemTotal", 8000.0}};
+    deadband.evaluate(at(0), {{&metric, memory}});
+
+    memory["MemFree"] = 1200.0;
+    memory["MemTotal"] = 8001.0;
+    EXPECT_EQ(deadband.evaluate(at(1), {{&metric, memory}}), 1u);
+    EXPECT_TRUE(deadband.emitted(&metric, 0));
+    EXPECT_FALSE(deadband.emitted(&metric, 1));
+}
+
+TEST(DeadbandTest, MapSeriesTrackedByKey) {
+    Deadband deadband(json{{"abs", 1.0}});
+    FakeMetric metric;
+
+    deadband.evaluate(at(0), {{&metric, std::map<std::string, double>{{"eth0", 10.0},
+                                                                       {"veth1", 500.0}}}});
+
+    // veth1 заменён на veth2 с тем же числом ключей: veth2 новый и
+    // выводится, eth0 сравнивается со своим значением, а не с чужим
+    EXPECT_EQ(deadband.evaluate(at(1), {{&metric, std::map<std::string, double>{
+                                                      {"eth0", 10.5}, {"veth2", 500.0}}}}),
+              1u);
+    EXPECT_FALSE(deadband.emitted(&metric, 0));
+    EXPECT_TRUE(deadband.emitted(&metric, 1));
+
+    // Появление ключа перед eth0 не сбрасывает его состояние
+    EXPECT_EQ(deadband.evaluate(at(2), {{&metric, std::map<std::string, double>{
+                                                      {"bond0", 1.0}, {"eth0", 10.2},
+                                                      {"veth2", 500.0}}}}),
+              1u);
+    EXPECT_TRUE(deadband.emitted(&metric, 0));
+    EXPECT_FALSE(deadband.emitted(&metric, 1));
+    EXPECT_FALSE(deadband.emitted(&metric, 2));
+
+    // Исчезнувший и вернувшийся ключ начинается заново
+    deadband.evaluate(at(3), {{&metric, std::map<std::string, double>{{"eth0", 10.0}}}});
+    EXPECT_EQ(deadband.evaluate(at(4), {{&metric, std::map<std::string, double>{
+                                                      {"eth0", 10.0}, {"veth1", 500.0}}}}),
+              1u);
+    EXPECT_TRUE(deadband.emitted(&metric, 1));
+}
+
+TEST(DeadbandTest, VectorSeriesKeptWhenLengthChanges) {
+    Deadband deadband(json{{"abs", 1.0}});
+    FakeMetric metric;
+
+    deadband.evaluate(at(0), {{&metric, std::vector<double>{1.0, 2.0}}});
+    EXPECT_EQ(deadband.evaluate(at(1), {{&metric, std::vector<double>{1.0, 2.0, 3.0}}}), 1u);
+    EXPECT_FALSE(deadband.emitted(&metric, 0));
+    EXPECT_TRUE(deadband.emitted(&metric, 2));
+}
+
+TEST(DeadbandTest, SlowDriftAccumulates) {
+    Deadband deadband(json{{"abs", 1.0}});
+    FakeMetric metric;
+
+    deadband.evaluate(at(0), {{&metric, 0.0}});
+    EXPECT_EQ(deadband.evaluate(at(1), {{&metric, 0.6}}), 0u);
+    EXPECT_EQ(deadband.evaluate(at(2), {{&metric, 1.2}}), 1u);
+}
+
+TEST(DeadbandTest, Heartbeat) {
+    Deadband deadband(json{{"abs", 100.0}, {"heartbeat", 10}});
+    FakeMetric metric;
+
+    deadband.evaluate(at(0), {{&metric, 1.0}});
+    EXPECT_EQ(deadband.evaluate(at(5), {{&metric, 1.0}}), 0u);
+    EXPECT_EQ(deadband.evaluate(at(10), {{&metric, 1.0}}), 1u);
+    EXPECT_EQ(deadband.evaluate(at(15), {{&metric, 1.0}}), 0u);
+}
+
+TEST(DeadbandTest, FileOutputSkipsUnchangedTicks) {
+    const std::string test_file = "deadband_output.log";
+    {
+        FileOutput output(json{{"file", test_file}, {"deadband", {{"abs", 1.0}}}});
+        ASSERT_TRUE(output.is_valid());
+
+        FakeMetric metric;
+        output.write({{&metric, std::vector<double>{5.0}}});
+        output.write({{&metric, std::vector<double>{5.5}}});
+        output.write({{&metric, std::vector<double>{7.0}}});
+    }
+
+    std::ifstream file(test_file);
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    std::remove(test_file.c_str());
+
+    size_t ticks = 0;
+    for (size_t pos = content.find("=== Metrics"); pos != std::string::npos;
+         pos = content.find("=== Metrics", pos + 1)) {
+        ++ticks;
+    }
+    EXPECT_EQ(ticks, 2u);
+    EXPECT_NE(content.find("CPU 0: 7.00%"), std::string::npos);
+    EXPECT_EQ(content.find("CPU 0: 5.50%"), std::string::npos);
+}
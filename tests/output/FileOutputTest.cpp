@@ -1,6 +1,7 @@
 #include "output/FileOutput.hpp"
 #include "metrics/CPUMetric.hpp"
 #include "metrics/MemoryMetric.hpp"
+#include "FakeMetric.hpp"
 #include <gtest/gtest.h>
 #include <fstream>
 
@@ -50,3 +51,48 @@ TEST_F(FileOutputTest, Write) {
     EXPECT_TRUE(content.find("[cpu]") != std::string::npos);
     EXPECT_TRUE(content.find("[memory]") != std::string::npos);
 }
+
+TEST_F(FileOutputTest, WriteUsesTickTimestamp) {
+    json config = {{"file", test_file}};
+    FileOutput output(config);
+    ASSERT_TRUE(output.is_valid());
+
+    json memory_config = {{"spec", {"MemTotal"}}};
+    auto memory_metric = std::make_unique<MemoryMetric>(memory_config);
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values;
+    metric_values.push_back({memory_metric.get(), memory_metric->collect()});
+
+    Timestamp tick{0, 1700000000123000000};
+    output.write(tick, metric_values);
+
+    std::ifstream file(test_file);
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    // Дата зависит от часового пояса, миллисекунды - нет
+    EXPECT_NE(content.find("=== Metrics at 2023-11-1"), std::string::npos);
+    EXPECT_NE(content.find(":20.123"), std::string::npos);
+}
+
+TEST_F(FileOutputTest, UnitsComeFromMetric) {
+    FileOutput output(json{{"file", test_file}});
+    ASSERT_TRUE(output.is_valid());
+
+    json memory_config = {{"spec", {"MemTotal"}}};
+    auto memory_metric = std::make_unique<MemoryMetric>(memory_config);
+    // Имя "memory" само по себе не даёт единиц
+    FakeMetric impostor("node1/memory", "");
+    FakeMetric net("net", "B/s");
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values = {
+        {memory_metric.get(), std::map<std::string, double>{{"MemTotal", 1.0}}},
+        {&impostor, std::map<std::string, double>{{"Other", 2.0}}},
+        {&net, std::map<std::string, double>{{"eth0.rx_bytes", 3.0}}},
+    };
+    output.write(metric_values);
+
+    std::ifstream file(test_file);
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("MemTotal: 1.00 MB\n"), std::string::npos);
+    EXPECT_NE(content.find("Other: 2.00\n"), std::string::npos);
+    EXPECT_NE(content.find("eth0.rx_bytes: 3.00 B/s\n"), std::string::npos);
+}
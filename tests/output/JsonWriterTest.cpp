@@ -0,0 +1,81 @@
+#include "output/JsonWriter.hpp"
+#include <gtest/gtest.h>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+TEST(JsonWriterTest, NestedStructure) {
+    JsonWriter writer;
+    writer.begin_object();
+    writer.key("a");
+    writer.value(1);
+    writer.key("b");
+    writer.begin_array();
+    writer.value(1.5);
+    writer.value(-2.25);
+    writer.end_array();
+    writer.key("c");
+    writer.begin_object();
+    writer.end_object();
+    writer.key("d");
+    writer.begin_array();
+    writer.boolean(true);
+    writer.boolean(false);
+    writer.end_array();
+    writer.end_object();
+
+    EXPECT_EQ(writer.view(), R"({"a":1,"b":[1.5,-2.25],"c":{},"d":[true,false]})");
+}
+
+TEST(JsonWriterTest, EscapesStrings) {
+    JsonWriter writer;
+    std::string text = "quote\" slash\\ line\n tab\t ctl\x01 юникод";
+    writer.value(text);
+
+    auto parsed = json::parse(writer.view());
+    EXPECT_EQ(parsed.get<std::string>(), text);
+    EXPECT_NE(writer.view().find("\\u0001"), std::string_view::npos);
+}
+
+TEST(JsonWriterTest, DoublesRoundTrip) {
+    JsonWriter writer;
+    std::vector<double> values = {0.0, 0.1, 1e-300, 123456.789, -42.0, 1.0 / 3.0};
+    writer.begin_array();
+    for (double v : values) {
+        writer.value(v);
+    }
+    writer.end_array();
+
+    auto parsed = json::parse(writer.view());
+    ASSERT_EQ(parsed.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(parsed[i].get<double>(), values[i]);
+    }
+}
+
+TEST(JsonWriterTest, NonFiniteAsNull) {
+    JsonWriter writer;
+    writer.begin_array();
+    writer.value(std::numeric_limits<double>::quiet_NaN());
+    writer.value(std::numeric_limits<double>::infinity());
+    writer.end_array();
+
+    EXPECT_EQ(writer.view(), "[null,null]");
+}
+
+TEST(JsonWriterTest, ClearReusesBuffer) {
+    JsonWriter writer(16);
+    writer.begin_object();
+    writer.key("x");
+    writer.value(1);
+    writer.end_object();
+
+    writer.clear();
+    EXPECT_EQ(writer.size(), 0u);
+
+    writer.begin_array();
+    writer.value(2);
+    writer.end_array();
+    EXPECT_EQ(writer.view(), "[2]");
+}
@@ -0,0 +1,139 @@
+#include "output/JsonlOutput.hpp"
+#include "FakeMetric.hpp"
+#include "metrics/CPUMetric.hpp"
+#include "metrics/MemoryMetric.hpp"
+#include <gtest/gtest.h>
+#include <fstream>
+
+class JsonlOutputTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_file = "test_output.jsonl";
+    }
+
+    void TearDown() override {
+        std::remove(test_file.c_str());
+    }
+
+    std::string test_file;
+};
+
+TEST_F(JsonlOutputTest, ValidConfig) {
+    json config = {{"path", test_file}};
+    JsonlOutput output(config);
+    EXPECT_TRUE(output.is_valid());
+}
+
+TEST_F(JsonlOutputTest, InvalidConfigMissingPath) {
+    json config = json::object();
+    JsonlOutput output(config);
+    EXPECT_FALSE(output.is_valid());
+}
+
+TEST_F(JsonlOutputTest, WriteOneLinePerTick) {
+    json config = {{"path", test_file}};
+    JsonlOutput output(config);
+    ASSERT_TRUE(output.is_valid());
+
+    std::vector<std::pair<const IMetric*, MetricValue>> metric_values;
+
+    json cpu_config = {{"cpu_ids", {0, 1}}};
+    auto cpu_metric = std::make_unique<CPUMetric>(cpu_config);
+    metric_values.push_back({cpu_metric.get(), cpu_metric->collect()});
+
+    json memory_config = {{"spec", {"MemTotal", "MemFree"}}};
+    auto memory_metric = std::make_unique<MemoryMetric>(memory_config);
+    metric_values.push_back({memory_metric.get(), memory_metric->collect()});
+
+    EXPECT_NO_THROW(output.write(metric_values));
+    EXPECT_NO_THROW(output.write(metric_values));
+
+    std::ifstream file(test_file);
+    std::string line;
+    int lines = 0;
+    while (std::getline(file, line)) {
+        auto record = json::parse(line);
+        EXPECT_TRUE(record["timestamp"].is_number_integer());
+        EXPECT_FALSE(record.contains("event"));
+        EXPECT_EQ(record["cpu"].size(), 2u);
+        EXPECT_GT(record["memory"]["MemTotal"].get<double>(), 0.0);
+        ++lines;
+    }
+    EXPECT_EQ(lines, 2);
+}
+
+TEST_F(JsonlOutputTest, MatchesNlohmann) {
+    json memory_config = {{"spec", {"MemTotal"}}};
+    MemoryMetric memory_metric(memory_config);
+    std::map<std::string, double> memory = {{"Mem\"Total", 1024.5}, {"MemFree", 0.125}};
+
+    JsonWriter writer;
+    JsonlOutput::MetricKeys keys;
+    JsonlOutput::serialize(writer, 1700000000123, {{&memory_metric, memory}}, keys);
+
+    json expected = {{"timestamp", 1700000000123}, {"memory", memory}};
+    EXPECT_EQ(json::parse(writer.view()), expected);
+}
+
+TEST_F(JsonlOutputTest, EventWritesSeparateLine) {
+    JsonlOutput output(json{{"path", test_file}});
+    ASSERT_TRUE(output.is_valid());
+
+    json memory_config = {{"spec", {"MemFree"}}};
+    auto memory_metric = std::make_unique<MemoryMetric>(memory_config);
+    Timestamp tick;
+    tick.realtime_ns = 5000000;
+    output.write_event(tick, memory_metric.get(), std::map<std::string, double>{{"MemFree", 1.0}});
+
+    std::ifstream file(test_file);
+    std::string line;
+    ASSERT_TRUE(std::getline(file, line));
+    auto record = json::parse(line);
+    EXPECT_EQ(record["timestamp"].get<int64_t>(), 5);
+    EXPECT_EQ(record["event"], true);
+    EXPECT_DOUBLE_EQ(record["memory"]["MemFree"].get<double>(), 1.0);
+    EXPECT_FALSE(std::getline(file, line));
+}
+
+namespace {
+
+// Считает запросы имени, чтобы проверить кэширование ключей
+class CountingMetric : public FakeMetric {
+public:
+    using FakeMetric::FakeMetric;
+    std::string name() const override {
+        ++calls;
+        return FakeMetric::name();
+    }
+
+    mutable int calls = 0;
+};
+
+} // namespace
+
+TEST_F(JsonlOutputTest, KeysCachedAndUnique) {
+    CountingMetric cpu("cpu");
+    CountingMetric other_cpu("cpu");
+    CountingMetric reserved("timestamp");
+    std::vector<std::pair<const IMetric*, MetricValue>> values = {
+        {&cpu, 1.0}, {&other_cpu, 2.0}, {&reserved, 3.0}};
+
+    JsonWriter writer;
+    JsonlOutput::MetricKeys keys;
+    for (int tick = 0; tick < 3; ++tick) {
+        writer.clear();
+        JsonlOutput::serialize(writer, 1000, values, keys);
+    }
+    // Имена запрашиваются один раз на набор метрик, а не на каждом тике
+    EXPECT_EQ(cpu.calls, 1);
+    EXPECT_EQ(reserved.calls, 1);
+
+    json expected = {{"timestamp", 1000}, {"cpu", 1.0}, {"cpu#2", 2.0}, {"timestamp#2", 3.0}};
+    EXPECT_EQ(json::parse(writer.view()), expected);
+
+    // Событие использует тот же ключ, что и строки тиков
+    writer.clear();
+    JsonlOutput::serialize(writer, 2000, {{&other_cpu, 5.0}}, keys, true);
+    json event = {{"timestamp", 2000}, {"event", true}, {"cpu#2", 5.0}};
+    EXPECT_EQ(json::parse(writer.view()), event);
+}
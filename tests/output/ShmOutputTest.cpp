@@ -0,0 +1,281 @@
+#include "output/ShmOutput.hpp"
+#include "FakeMetric.hpp"
+#include "shm/SnapshotReader.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+using Values = std::vector<std::pair<const IMetric*, MetricValue>>;
+
+std::string segment_name(const std::string &suffix) {
+    return "/status_monitor_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+Timestamp tick_at(int64_t ns) {
+    Timestamp tick;
+    tick.monotonic_ns = ns;
+    tick.realtime_ns = ns;
+    return tick;
+}
+
+} // namespace
+
+TEST(ShmOutputTest, InvalidConfig) {
+    EXPECT_FALSE(ShmOutput(json::object()).is_valid());
+    EXPECT_THROW(ShmOutput(json{{"name", "no_slash"}}), std::invalid_argument);
+    EXPECT_THROW(ShmOutput(json{{"name", "/a/b"}}), std::invalid_argument);
+    EXPECT_THROW(ShmOutput(json{{"name", segment_name("cap")}, {"capacity", 0}}),
+                 std::invalid_argument);
+    EXPECT_THROW(ShmOutput(json{{"name", segment_name("unlink")}, {"unlink", 1}}),
+                 std::invalid_argument);
+}
+
+TEST(ShmOutputTest, ReaderSeesSchemaAndValues) {
+    std::string name = segment_name("basic");
+    ShmOutput output(json{{"name", name}});
+    ASSERT_TRUE(output.is_valid());
+
+    FakeMetric cpu("cpu");
+    FakeMetric memory("memory");
+    FakeMetric governor("governor");
+    std::map<std::string, double> meminfo = {{"MemFree", 512.0}, {"MemTotal", 1024.0}};
+    Values values = {
+        {&cpu, std::vector<double>{10.0, 20.0}},
+        {&memory, meminfo},
+        {&governor, 0.5},
+    };
+    output.write(tick_at(42), values);
+
+    shm_snapshot::SnapshotReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+    shm_snapshot::Snapshot snapshot;
+    ASSERT_TRUE(reader.read(snapshot));
+
+    std::vector<std::string> expected_names = {"cpu/0", "cpu/1", "memory/MemFree",
+                                               "memory/MemTotal", "governor"};
+    std::vector<double> expected_values = {10.0, 20.0, 512.0, 1024.0, 0.5};
+    EXPECT_EQ(snapshot.names, expected_names);
+    EXPECT_EQ(snapshot.values, expected_values);
+    EXPECT_EQ(snapshot.realtime_ns, 42);
+    EXPECT_EQ(snapshot.sequence % 2, 0u);
+    EXPECT_EQ(snapshot.find("memory/MemTotal"), 3);
+    EXPECT_EQ(snapshot.find("missing"), -1);
+
+    // Смена набора рядов меняет поколение схемы
+    uint64_t generation = snapshot.schema_generation;
+    values[0].second = std::vector<double>{30.0};
+    output.write(tick_at(43), values);
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_NE(snapshot.schema_generation, generation);
+    EXPECT_EQ(snapshot.names.size(), 4u);
+    EXPECT_EQ(snapshot.names[0], "cpu/0");
+    EXPECT_EQ(snapshot.values[0], 30.0);
+}
+
+TEST(ShmOutputTest, EventUpdatesSeriesInPlace) {
+    std::string name = segment_name("event");
+    ShmOutput output(json{{"name", name}});
+    ASSERT_TRUE(output.is_valid());
+
+    FakeMetric cpu("cpu");
+    FakeMetric psi("psi");
+    Values values = {
+        {&cpu, std::vector<double>{10.0, 20.0}},
+        {&psi, std::map<std::string, double>{{"memory.some.avg10", 1.0},
+                                             {"memory.some.total", 100.0}}},
+    };
+    output.write(tick_at(1), values);
+
+    shm_snapshot::SnapshotReader reader(name);
+    shm_snapshot::Snapshot snapshot;
+    ASSERT_TRUE(reader.read(snapshot));
+    uint64_t generation = snapshot.schema_generation;
+
+    // Событие PSI с лишним ключом триггера: обновляются только известные
+    // ряды, снимок cpu и схема остаются на месте
+    output.write_event(tick_at(2), &psi,
+                       std::map<std::string, double>{{"memory.some.avg10", 40.0},
+                                                     {"memory.some.total", 900.0},
+                                                     {"memory.some.trigger", 1.0}});
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_EQ(snapshot.schema_generation, generation);
+    std::vector<std::string> expected_names = {"cpu/0", "cpu/1", "psi/memory.some.avg10",
+                                               "psi/memory.some.total"};
+    std::vector<double> expected_values = {10.0, 20.0, 40.0, 900.0};
+    EXPECT_EQ(snapshot.names, expected_names);
+    EXPECT_EQ(snapshot.values, expected_values);
+    EXPECT_EQ(snapshot.realtime_ns, 2);
+
+    // Вектор другой длины и неизвестная метрика не публикуются
+    FakeMetric other("other");
+    output.write_event(tick_at(3), &cpu, std::vector<double>{1.0});
+    output.write_event(tick_at(3), &other, 5.0);
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_EQ(snapshot.values, expected_values);
+    EXPECT_EQ(snapshot.schema_generation, generation);
+}
+
+TEST(ShmOutputTest, TruncatesToCapacity) {
+    std::string name = segment_name("capacity");
+    ShmOutput output(json{{"name", name}, {"capacity", 3}});
+    ASSERT_TRUE(output.is_valid());
+
+    FakeMetric cpu("cpu");
+    output.write(tick_at(1), Values{{&cpu, std::vector<double>{1, 2, 3, 4, 5}}});
+    EXPECT_EQ(output.truncated_series(), 2u);
+
+    shm_snapshot::SnapshotReader reader(name);
+    shm_snapshot::Snapshot snapshot;
+    ASSERT_TRUE(reader.read(snapshot));
+    std::vector<double> expected = {1, 2, 3};
+    EXPECT_EQ(snapshot.values, expected);
+}
+
+TEST(ShmOutputTest, ReaderRejectsLayoutBeyondItsMapping) {
+    std::string name = segment_name("grow");
+    FakeMetric metric("load");
+    shm_snapshot::SnapshotReader reader;
+    {
+        ShmOutput output(json{{"name", name}, {"capacity", 4}, {"unlink", false}});
+        output.write(tick_at(1), Values{{&metric, std::vector<double>{1, 2, 3}}});
+        ASSERT_TRUE(reader.open(name));
+    }
+
+    // Писатель перезапущен с большей ёмкостью: смещения в заголовке выходят
+    // за отображение читателя, чтение должно отказать, а не упасть
+    ShmOutput output(json{{"name", name}, {"capacity", 4096}});
+    output.write(tick_at(2), Values{{&metric, std::vector<double>(4096, 7.0)}});
+
+    shm_snapshot::Snapshot snapshot;
+    EXPECT_FALSE(reader.read(snapshot));
+
+    ASSERT_TRUE(reader.open(name));
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_EQ(snapshot.values.size(), 4096u);
+    EXPECT_EQ(snapshot.values.back(), 7.0);
+}
+
+TEST(ShmOutputTest, RestartKeepsReaderSchemaCurrent) {
+    std::string name = segment_name("restart");
+    FakeMetric load("load");
+    FakeMetric temp("temp");
+    shm_snapshot::SnapshotReader reader;
+    shm_snapshot::Snapshot snapshot;
+    {
+        ShmOutput output(json{{"name", name}, {"unlink", false}});
+        output.write(tick_at(1), Values{{&load, std::vector<double>{1, 2}}});
+        ASSERT_TRUE(reader.open(name));
+        ASSERT_TRUE(reader.read(snapshot));
+        EXPECT_EQ(snapshot.names[0], "load/0");
+    }
+
+    // Перезапущенный писатель публикует те же два ряда под другими именами:
+    // подключённый читатель должен перечитать имена, а номер не должен откатиться
+    uint64_t previous_sequence = snapshot.sequence;
+    ShmOutput output(json{{"name", name}});
+    output.write(tick_at(2), Values{{&temp, std::vector<double>{3, 4}}});
+
+    ASSERT_TRUE(reader.read(snapshot));
+    EXPECT_GT(snapshot.sequence, previous_sequence);
+    ASSERT_EQ(snapshot.names.size(), 2u);
+    EXPECT_EQ(snapshot.names[0], "temp/0");
+    EXPECT_EQ(snapshot.names[1], "temp/1");
+    EXPECT_EQ(snapshot.values, (std::vector<double>{3, 4}));
+}
+
+TEST(ShmOutputTest, UnlinksSegmentOnDestruction) {
+    std::string name = segment_name("unlinked");
+    {
+        ShmOutput output(json{{"name", name}});
+        ASSERT_TRUE(output.is_valid());
+    }
+    shm_snapshot::SnapshotReader reader;
+    EXPECT_FALSE(reader.open(name));
+}
+
+// Несколько читателей крутятся на сегменте, пока писатель публикует тики
+// и периодически меняет схему: число рядов и имя метрики. Любой разорванный
+// снимок нарушит инвариант values[i] == values[0] + i или соответствие
+// имён значениям, а устаревшие имена схемы - префикс имён рядов.
+TEST(ShmOutputTest, ConcurrentReadersNeverSeeTornSnapshots) {
+    std::string name = segment_name("stress");
+    ShmOutput output(json{{"name", name}});
+    ASSERT_TRUE(output.is_valid());
+
+    // Схема меняется каждые 500 тиков: load x256, temp x256, load x128.
+    // Две схемы подряд совпадают по числу рядов и отличаются только именами.
+    FakeMetric load("load");
+    FakeMetric temp("temp");
+    auto phase = [](int64_t tick) { return (tick / 500) % 3; };
+    std::vector<double> series(256);
+    for (size_t i = 0; i < series.size(); ++i) {
+        series[i] = static_cast<double>(i);
+    }
+    Values values = {{&load, series}};
+    output.write(tick_at(0), values);
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> snapshots{0};
+
+    auto reader_loop = [&]() {
+        shm_snapshot::SnapshotReader reader(name);
+        if (!reader.is_open()) {
+            ++failures;
+            return;
+        }
+        shm_snapshot::Snapshot snapshot;
+        uint64_t last_sequence = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (!reader.read(snapshot)) {
+                continue;
+            }
+            bool ok = snapshot.sequence >= last_sequence &&
+                      snapshot.names.size() == snapshot.values.size() &&
+                      !snapshot.values.empty() &&
+                      snapshot.values[0] == static_cast<double>(snapshot.realtime_ns);
+            std::string prefix = phase(snapshot.realtime_ns) == 1 ? "temp/" : "load/";
+            for (size_t i = 0; ok && i < snapshot.values.size(); ++i) {
+                ok = snapshot.values[i] == snapshot.values[0] + static_cast<double>(i) &&
+                     snapshot.names[i] == prefix + std::to_string(i);
+            }
+            if (!ok) {
+                ++failures;
+            }
+            last_sequence = snapshot.sequence;
+            ++snapshots;
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back(reader_loop);
+    }
+
+    // Пишем, пока читатели не наберут достаточно снимков, но не дольше 2 с
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    for (int64_t tick = 1; tick <= 20000 || (snapshots.load() < 20000 &&
+                                             std::chrono::steady_clock::now() < deadline);
+         ++tick) {
+        values[0].first = phase(tick) == 1 ? &temp : &load;
+        size_t size = phase(tick) == 2 ? 128 : 256;
+        auto &current = std::get<std::vector<double>>(values[0].second);
+        current.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            current[i] = static_cast<double>(tick) + static_cast<double>(i);
+        }
+        output.write(tick_at(tick), values);
+    }
+
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_GT(snapshots.load(), 0u);
+}
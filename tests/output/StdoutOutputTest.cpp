@@ -0,0 +1,133 @@
+#include "output/StdoutOutput.hpp"
+#include "FakeMetric.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+using Values = std::vector<std::pair<const IMetric*, MetricValue>>;
+
+Timestamp tick_at_ms(int64_t ms) {
+    Timestamp tick;
+    tick.monotonic_ns = ms * 1000000;
+    tick.realtime_ns = ms * 1000000;
+    return tick;
+}
+
+} // namespace
+
+TEST(StdoutOutputTest, InvalidFormat) {
+    std::ostringstream out;
+    EXPECT_THROW(StdoutOutput(json{{"format", "csv"}}, out), std::invalid_argument);
+    EXPECT_EQ(StdoutOutput(json::object(), out).format(), StdoutOutput::Format::Jsonl);
+}
+
+TEST(StdoutOutputTest, JsonlLinePerTick) {
+    std::ostringstream out;
+    StdoutOutput output(json{{"format", "jsonl"}}, out);
+    ASSERT_TRUE(output.is_valid());
+
+    FakeMetric cpu("cpu");
+    FakeMetric memory("memory");
+    Values values = {{&cpu, std::vector<double>{12.5, 30.0}},
+                     {&memory, std::map<std::string, double>{{"MemFree", 512.0}}}};
+    output.write(tick_at_ms(1000), values);
+    output.write(tick_at_ms(2000), values);
+    output.finish();
+
+    std::istringstream lines(out.str());
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) {
+        auto record = json::parse(line);
+        EXPECT_EQ(record["timestamp"].get<int64_t>(), 1000 * (count + 1));
+        EXPECT_DOUBLE_EQ(record["cpu"][0].get<double>(), 12.5);
+        EXPECT_DOUBLE_EQ(record["memory"]["MemFree"].get<double>(), 512.0);
+        ++count;
+    }
+    EXPECT_EQ(count, 2);
+}
+
+TEST(StdoutOutputTest, PrometheusText) {
+    std::ostringstream out;
+    StdoutOutput output(json{{"format", "prometheus"}}, out);
+
+    FakeMetric cpu("cpu");
+    FakeMetric net("net");
+    FakeMetric governor("governor.skip");
+    FakeMetric disk("disk");
+    Values values = {{&cpu, std::vector<double>{12.5, 30.0}},
+                     {&disk, std::map<std::string, double>{}},
+                     {&net, std::map<std::string, double>{{"eth0.rx_bytes", 100.0}}},
+                     {&governor, 3}};
+    output.write(tick_at_ms(1500), values);
+
+    EXPECT_EQ(out.str(),
+              "# TYPE status_monitor_cpu gauge\n"
+              "status_monitor_cpu{index=\"0\"} 12.5 1500\n"
+              "status_monitor_cpu{index=\"1\"} 30 1500\n"
+              "# TYPE status_monitor_net gauge\n"
+              "status_monitor_net{key=\"eth0.rx_bytes\"} 100 1500\n"
+              "# TYPE status_monitor_governor_skip gauge\n"
+              "status_monitor_governor_skip 3 1500\n");
+}
+
+TEST(StdoutOutputTest, PrometheusTypeOncePerFamily) {
+    std::ostringstream out;
+    StdoutOutput output(json{{"format", "prometheus"}}, out);
+
+    FakeMetric load("load");
+    output.write(tick_at_ms(1000), Values{{&load, 1.0}});
+    output.write(tick_at_ms(2000), Values{{&load, 2.0}});
+
+    EXPECT_EQ(out.str(),
+              "# TYPE status_monitor_load gauge\n"
+              "status_monitor_load 1 1000\n"
+              "status_monitor_load 2 2000\n");
+}
+
+TEST(StdoutOutputTest, PrometheusNonFinite) {
+    std::ostringstream out;
+    StdoutOutput output(json{{"format", "prometheus"}}, out);
+
+    FakeMetric load("load");
+    output.write(tick_at_ms(1000),
+                 Values{{&load, std::vector<double>{std::nan(""), HUGE_VAL, -HUGE_VAL}}});
+
+    EXPECT_EQ(out.str(),
+              "# TYPE status_monitor_load gauge\n"
+              "status_monitor_load{index=\"0\"} NaN 1000\n"
+              "status_monitor_load{index=\"1\"} +Inf 1000\n"
+              "status_monitor_load{index=\"2\"} -Inf 1000\n");
+}
+
+TEST(StdoutOutputTest, EventLinesAreMarked) {
+    FakeMetric psi("psi");
+    MetricValue event = std::map<std::string, double>{{"memory.some.trigger", 1.0}};
+
+    std::ostringstream jsonl;
+    StdoutOutput jsonl_output(json{{"format", "jsonl"}}, jsonl);
+    jsonl_output.write(tick_at_ms(1000), Values{{&psi, 0.5}});
+    jsonl_output.write_event(tick_at_ms(1200), &psi, event);
+
+    std::istringstream lines(jsonl.str());
+    std::string line;
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_FALSE(json::parse(line).contains("event"));
+    ASSERT_TRUE(std::getline(lines, line));
+    auto record = json::parse(line);
+    EXPECT_EQ(record["event"], true);
+    EXPECT_DOUBLE_EQ(record["psi"]["memory.some.trigger"].get<double>(), 1.0);
+
+    std::ostringstream prometheus;
+    StdoutOutput prometheus_output(json{{"format", "prometheus"}}, prometheus);
+    prometheus_output.write_event(tick_at_ms(1200), &psi, event);
+    prometheus_output.write_event(tick_at_ms(1300), &psi, 2.0);
+    EXPECT_NE(prometheus.str().find(
+                  "status_monitor_psi{key=\"memory.some.trigger\",event=\"true\"} 1 1200\n"),
+              std::string::npos);
+    EXPECT_NE(prometheus.str().find("status_monitor_psi{event=\"true\"} 2 1300\n"),
+              std::string::npos);
+}